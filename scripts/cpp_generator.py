@@ -157,6 +157,24 @@ def _is_static_length_string(member):
     return member.type == "char" and _is_static_length_array(member)
 
 
+_C_ARITHMETIC_TYPES = {"char", "float", "double", "int8_t", "uint8_t", "int16_t", "uint16_t", "int32_t", "uint32_t",
+                       "int64_t", "uint64_t", "size_t", "int", "uintptr_t"}
+
+
+def _compares_by_bytes(member):
+    """True if a member is a value of a platform type, which might have no operator== or std::hash: e.g. LUID."""
+    return member.pointer_count == 0 and not member.type.startswith("Xr") and member.type not in _C_ARITHMETIC_TYPES
+
+
+def _param_type(param):
+    """Strip the parameter name from a C parameter declaration, leaving just its type."""
+    decl = param.cdecl.strip()
+    pos = decl.rfind(param.name)
+    if pos < 0:
+        return decl
+    return (decl[:pos] + decl[pos + len(param.name):]).strip()
+
+
 def _block_comment(s, doxygen=False):
     def clean_line(line):
         line = line.rstrip()
@@ -196,6 +214,29 @@ def _block_doxygen_comment(s):
     return _block_comment(s, doxygen=True)
 
 
+class CloneStep:
+    """One member of a struct to follow when deep copying it.
+
+    kind is one of:
+    - "nested": a struct by value (or a fixed-size array of them) that itself needs fixing up
+    - "string": a null-terminated string
+    - "string_array": an array of count null-terminated strings
+    - "bytes": a void pointer to count bytes
+    - "array": an array of count elements of element_type (count is "1" for a plain pointer)
+    - "pointer_array": an array of count pointers to single elements of element_type
+    - "polymorphic": a pointer to a struct whose type is some child of the abstract element_type
+    - "polymorphic_array": an array of count pointers to such structs
+    """
+
+    def __init__(self, kind, member, count=None, element_type=None, element_fixup=False):
+        self.kind = kind
+        self.name = member.name
+        self.is_static_array = member.is_array and member.pointer_count == 0
+        self.count = count
+        self.element_type = element_type
+        self.element_fixup = element_fixup
+
+
 class StructProjection:
     """Stores the struct details implementation."""
 
@@ -235,6 +276,10 @@ class StructProjection:
 
         self.struct_type_enum = gen._get_tag(struct.name) if self.has_type_enum_value else None
 
+        # Fixed-size array members are filled in by a loop in the constructor body, only allowed in a constexpr function as of C++14.
+        has_static_length_array = any(_is_static_length_array(member) for member in struct.members)
+        self.constexpr_keyword = "OPENXR_HPP_CONSTEXPR14" if has_static_length_array else "OPENXR_HPP_CONSTEXPR"
+
     @property
     def struct_parent_decl(self):
         if self.typed_struct:
@@ -332,6 +377,9 @@ class MethodProjection:
         self.explicit_result_elided = False
         """If true, our most advanced enhanced wrapper doesn't have an XrResult anywhere."""
 
+        self.allocates = False
+        """If true, the wrapper allocates (e.g. a two-call vector), so may throw std::bad_alloc regardless of exception settings."""
+
     @property
     def qualified_name(self):
         if self.handle and self.is_member_function:
@@ -408,6 +456,28 @@ class MethodProjection:
     def get_success_codes(self):
         return [x for x in self.cpp_return_codes if "Error" not in x and "LossPending" not in x]
 
+    def get_noexcept_spec(self, exceptions_allowed=False):
+        """Return the exception specification for this wrapper, given how it reports errors.
+
+        A wrapper cannot throw if it does not allocate, does not throw on error,
+        and the dispatch entry point it forwards to is itself noexcept.
+        exceptions_allowed has the same meaning as in the templates: True, False, or "maybe"."""
+        if self.allocates or exceptions_allowed is True:
+            return ""
+        dispatch_call = "d.{}({})".format(
+            self.name,
+            ", ".join("std::declval<{}>()".format(_param_type(param)) for param in self.params))
+        if exceptions_allowed == "maybe":
+            return "OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS(noexcept({}))".format(dispatch_call)
+        return "noexcept(noexcept({}))".format(dispatch_call)
+
+    @property
+    def nodiscard(self):
+        """The attribute to put in front of the declaration if this wrapper returns something."""
+        if self.return_type == "void":
+            return ""
+        return "OPENXR_HPP_NODISCARD"
+
     @property
     def qualifiers(self):
         if self.handle and not self.is_destroy:
@@ -722,6 +792,7 @@ class CppGenerator(AutomaticSourceOutputGenerator):
 
         method.is_two_call = True
         method.masks_simple = False
+        method.allocates = True
         # Should we put "ToVector" on the method name?
         needs_name_decoration = True
         item_type = array_param['param'].type
@@ -772,6 +843,42 @@ class CppGenerator(AutomaticSourceOutputGenerator):
             self._append_to_method_name_before_vendor(method, "ToVector")
         self._update_enhanced_return_type(method)
 
+    def _input_array_element_type(self, typename):
+        """The C++ type to view the elements of an input array parameter as: projected if of identical layout, else raw."""
+        if typename in SKIP_PROJECTION:
+            return typename
+        if typename in self.dict_structs and self._is_base_only(self.dict_structs[typename]):
+            return None
+        if typename in self.projected_types or typename in self.dict_handles or typename in MANUALLY_PROJECTED_SCALARS:
+            return _project_type_name(typename)
+        return typename
+
+    def _enhanced_method_projection_input_arrays(self, method):
+        """Fold each "count, const T* array" parameter pair into a single Span<const T> parameter."""
+        for param in method.decl_params:
+            if not param.is_const or param.pointer_count != 1 or param.type in ("void", "char"):
+                continue
+            count_name = param.pointer_count_var
+            counts = [p for p in method.decl_params if p.name == count_name and p.pointer_count == 0]
+            if not counts or CAPACITY_INPUT_RE.match(count_name):
+                continue
+            if any(p is not param and p.pointer_count_var == count_name for p in method.decl_params):
+                # The count is shared with another array: leave them as they are.
+                continue
+            element_type = self._input_array_element_type(param.type)
+            if element_type is None:
+                # An array of a polymorphic type: its elements are not all the same size.
+                continue
+            name = param.name
+            method.masks_simple = False
+            method.decl_dict[count_name] = None
+            method.access_dict[count_name] = "static_cast<{}>({}.size())".format(counts[0].type, name)
+            method.decl_dict[name] = "Span<const {}> {}".format(element_type, name)
+            if element_type == param.type:
+                method.access_dict[name] = "{}.data()".format(name)
+            else:
+                method.access_dict[name] = "reinterpret_cast<const {}*>({}.data())".format(param.type, name)
+
     def _method_has_single_output(self, method):
         if len(method.get_success_codes()) > 1:
             return False
@@ -798,6 +905,7 @@ class CppGenerator(AutomaticSourceOutputGenerator):
         """Perform the manipulation of a MethodProjection to convert it from C to C++ for "enhanced mode"."""
         method.masks_simple = True
         self._basic_method_projection(method)
+        self._enhanced_method_projection_input_arrays(method)
         method.bare_return_type = "void"
         successes = method.get_success_codes()
         method.multiple_success_codes = len(successes) > 1
@@ -839,11 +947,16 @@ class CppGenerator(AutomaticSourceOutputGenerator):
 
             method.decl_params.pop()
             method.decl_dict[outparam.name] = None
-            method.pre_statements.append("{} returnVal;".format(cpp_outtype))
-            if outparam.type in self.projected_types:
-                method.access_dict[outparam.name] = "OPENXR_HPP_NAMESPACE::put(returnVal)"
+            if self._is_runtime_written_struct(outparam.type):
+                # The runtime fills in the whole struct: only type and next need to be written first.
+                method.pre_statements.append("{} returnVal{{Uninitialized{{}}}};".format(cpp_outtype))
+                method.access_dict[outparam.name] = "OPENXR_HPP_NAMESPACE::put(returnVal, false)"
             else:
-                method.access_dict[outparam.name] = "&returnVal"
+                method.pre_statements.append("{} returnVal;".format(cpp_outtype))
+                if outparam.type in self.projected_types:
+                    method.access_dict[outparam.name] = "OPENXR_HPP_NAMESPACE::put(returnVal)"
+                else:
+                    method.access_dict[outparam.name] = "&returnVal"
             method.returns.append("returnVal")
 
         self._update_enhanced_return_type(method)
@@ -919,6 +1032,136 @@ class CppGenerator(AutomaticSourceOutputGenerator):
             return False
         return tag_member[0].values is None
 
+    def _is_uninitializable_struct(self, typename):
+        """True if typename is projected as a struct with a constructor taking Uninitialized."""
+        if typename not in self.dict_structs or typename in MANUALLY_PROJECTED or typename in SKIP_PROJECTION:
+            return False
+        return not self._is_base_only(self.dict_structs[typename])
+
+    def _is_runtime_written_struct(self, typename):
+        """True if the runtime fills in the whole of a struct of this type, reading nothing but type and next.
+
+        In/out structs, carrying capacities or buffers for the runtime to write through, are excluded."""
+        if not self._is_uninitializable_struct(typename):
+            return False
+        struct = self.dict_structs[typename]
+        return struct.returned_only and not self._has_runtime_read_members(struct)
+
+    def _has_runtime_read_members(self, struct):
+        """True if any member of struct, or of a struct nested in it by value, is read by the runtime when output."""
+        for member in struct.members:
+            if member.name in ("type", "next"):
+                continue
+            if CAPACITY_INPUT_RE.match(member.name):
+                return True
+            if member.pointer_count > 0 and not member.is_const:
+                return True
+            if member.pointer_count == 0 and member.type in self.dict_structs:
+                if self._has_runtime_read_members(self.dict_structs[member.type]):
+                    return True
+        return False
+
+    def _is_uninitializable_member(self, member):
+        """True if member is a single, by-value struct that can itself be constructed from Uninitialized."""
+        return member.pointer_count == 0 and not member.is_array and self._is_uninitializable_struct(member.type)
+
+    def _member_len(self, struct_name, member_name):
+        """The len attribute of a struct member in the registry, split on commas: empty if there is none."""
+        info = self.registry.typedict.get(struct_name)
+        if info is None:
+            return []
+        for elem in info.elem.findall('member'):
+            if elem.findtext('name') == member_name:
+                length = elem.get('len')
+                return length.split(',') if length else []
+        return []
+
+    def _member_count_field(self, struct, member):
+        """The name of the sibling member holding the element count of a pointer member, or None if there is none."""
+        if member.pointer_count == 0:
+            return None
+        length = self._member_len(struct.name, member.name)
+        if length and length[0] in set(m.name for m in struct.members):
+            return length[0]
+        return None
+
+    def _member_written_count_field(self, struct, member):
+        """For a buffer the runtime writes to, whose count member is a `*CapacityInput`, the `*CountOutput` sibling.
+
+        None for other members, and for buffers with no such sibling."""
+        count_field = self._member_count_field(struct, member)
+        match = CAPACITY_INPUT_RE.match(count_field) if count_field else None
+        if not match:
+            return None
+        written = match.group('itemname') + 'CountOutput'
+        if written in set(m.name for m in struct.members):
+            return written
+        return None
+
+    def _needs_clone_fixup(self, typename):
+        """True if a deep copy of a struct of this type takes more than copying its bytes."""
+        if typename not in self.dict_structs or typename in SKIP_PROJECTION:
+            return False
+        if self._is_tagged_type(typename):
+            # at least the next chain
+            return True
+        return bool(self._clone_plan(self.dict_structs[typename]))
+
+    def _clone_plan(self, struct):
+        """The steps, besides copying the bytes and the next chain, to deep copy a struct: one CloneStep per member needing one.
+
+        Only pointers to const are followed: a deep copy is meant for input structs.
+        Pointers whose length the registry gives in a form we do not understand are copied shallowly.
+        """
+        if struct.name in self._clone_plans:
+            return self._clone_plans[struct.name]
+        member_names = set(m.name for m in struct.members)
+        # Recorded before recursing, so a struct pointing to its own type terminates.
+        steps = self._clone_plans[struct.name] = []
+        for member in struct.members:
+            if self._cpp_hidden_member(member):
+                continue
+            if member.pointer_count == 0:
+                if self._needs_clone_fixup(member.type):
+                    steps.append(CloneStep("nested", member, element_type=member.type))
+                continue
+            if not member.is_const or member.pointer_count > 2:
+                continue
+            length = self._member_len(struct.name, member.name)
+            count = None
+            if length and length[0] in member_names:
+                count = "s." + length[0]
+            elif length and length[0] != "null-terminated":
+                continue
+
+            if member.type == "char":
+                if member.pointer_count == 1 and length == ["null-terminated"]:
+                    steps.append(CloneStep("string", member))
+                elif member.pointer_count == 2 and count and length[1:] == ["null-terminated"]:
+                    steps.append(CloneStep("string_array", member, count=count))
+                continue
+            if member.type == "void":
+                if member.pointer_count == 1 and count:
+                    steps.append(CloneStep("bytes", member, count=count))
+                continue
+            if member.pointer_count == 1 and not count and member.type in self.dict_structs:
+                count = "1"
+            elif not count:
+                continue
+
+            element_typed = self._is_tagged_type(member.type)
+            if element_typed and self._is_base_only(self.dict_structs[member.type]):
+                # The size of each element depends on its type: only an array of pointers can be followed.
+                if member.pointer_count == 2:
+                    steps.append(CloneStep("polymorphic_array", member, count=count, element_type=member.type))
+                elif count == "1":
+                    steps.append(CloneStep("polymorphic", member, element_type=member.type))
+                continue
+            kind = "array" if member.pointer_count == 1 else "pointer_array"
+            steps.append(CloneStep(kind, member, count=count, element_type=member.type,
+                                   element_fixup=self._needs_clone_fixup(member.type)))
+        return steps
+
     def _cpp_hidden_member(self, member):
         return member.name == "type" or member.name == "next"
 
@@ -1023,6 +1266,9 @@ class CppGenerator(AutomaticSourceOutputGenerator):
             if member.type == 'char' and member.is_array and member.pointer_count == 0:
                 # We'll initialize a fixed-size string with a cstring.
                 result = "const char* " + member.name + suffix
+            elif _is_static_length_array(member) and not member.is_const:
+                # Copied element by element from the array the parameter decays to.
+                result = "const " + result
             elif member.type.startswith("Xr") and member.pointer_count == 0:
                 result = "const " + _project_type_name(member.type) + "& " + member.name + suffix
 
@@ -1092,6 +1338,18 @@ class CppGenerator(AutomaticSourceOutputGenerator):
             return set(child for child, parent in self.struct_parents.items() if parent == t)
 
         self.struct_children = {parent: children_of(parent) for parent in self.parents}
+        self._clone_plans = {}
+        # Structs whose deep copy takes more than copying their bytes.
+        self.cloneable_structs = [struct for struct in self.api_structures
+                                  if struct.name not in MANUALLY_PROJECTED and struct.name not in SKIP_PROJECTION
+                                  and not struct.alias and not self._is_base_only(struct)
+                                  and self._needs_clone_fixup(struct.name)]
+
+        # Every struct with a structextends attribute, mapped to the structs it may extend.
+        struct_extends = ((otherType.elem.get('name'), otherType.elem.get('structextends'))
+                          for otherType in self.registry.typedict.values())
+        self.struct_extends = {name: sorted(extends.split(',')) for name, extends in struct_extends
+                               if extends is not None}
 
         def fields_of(t):
             struct = self.dict_structs[t]
@@ -1163,8 +1421,14 @@ class CppGenerator(AutomaticSourceOutputGenerator):
             bitmask_for_flags=self._bitmask_for_flags,
             is_static_length_array=_is_static_length_array,
             is_static_length_string=_is_static_length_string,
+            compares_by_bytes=_compares_by_bytes,
+            is_uninitializable_member=self._is_uninitializable_member,
             struct_parents=self.struct_parents,
             struct_children=self.struct_children,
+            struct_extends=self.struct_extends,
+            clone_plan=self._clone_plan,
+            member_count_field=self._member_count_field,
+            member_written_count_field=self._member_written_count_field,
             struct_fields=self.struct_fields,
             project_struct=(lambda s: StructProjection(s, self)),
             get_default_for_member=self._get_default_for_member,
@@ -1182,6 +1446,11 @@ class CppGenerator(AutomaticSourceOutputGenerator):
         assert(self._is_struct_input(self.dict_structs['XrCompositionLayerBaseHeader']))
         assert(not self._is_struct_input(self.dict_structs['XrApplicationInfo']))
         assert(not self._is_struct_output(self.dict_structs['XrApplicationInfo']))
+        assert(self._is_runtime_written_struct('XrSystemProperties'))
+        assert(not self._is_runtime_written_struct('XrVisibilityMaskKHR'))
+        mask = self.dict_structs['XrVisibilityMaskKHR']
+        vertices = [m for m in mask.members if m.name == 'vertices'][0]
+        assert(self._member_written_count_field(mask, vertices) == 'vertexCountOutput')
         # index = self._index0_of_first_visible_defaultable_member(self.dict_structs['XrApplicationInfo'].members)
         # print(index)
         assert(self._index0_of_first_visible_defaultable_member(self.dict_structs['XrApplicationInfo'].members) == 0)
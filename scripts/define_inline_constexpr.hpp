@@ -53,7 +53,26 @@
 #endif
 #endif  // !OPENXR_HPP_CONSTEXPR
 
+#if !defined(OPENXR_HPP_CONSTEXPR14)
+#if (__cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)) && (!defined(_MSC_VER) || _MSC_VER >= 1910)
+#define OPENXR_HPP_CONSTEXPR14 constexpr
+#else
+#define OPENXR_HPP_CONSTEXPR14
+#endif
+#endif  // !OPENXR_HPP_CONSTEXPR14
+
 #if !defined(OPENXR_HPP_SWITCH_CONSTEXPR)
 //! @todo set this to constexpr in c++14
 #define OPENXR_HPP_SWITCH_CONSTEXPR
 #endif  // !OPENXR_HPP_SWITCH_CONSTEXPR
+
+#if !defined(OPENXR_HPP_NODISCARD)
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(nodiscard) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#define OPENXR_HPP_NODISCARD [[nodiscard]]
+#endif
+#endif
+#if !defined(OPENXR_HPP_NODISCARD)
+#define OPENXR_HPP_NODISCARD
+#endif
+#endif  // !OPENXR_HPP_NODISCARD
@@ -73,7 +73,7 @@ using /*{projected_type }*/ = Flags</*{projected_bits_type }*/, /*{flags.name}*/
 //! @brief Bitwise OR operator between two /*{projected_bits_type }*/ flag bits.
 //! @see /*{projected_bits_type }*/, /*{projected_type }*/, xr::Flags
 //# endfilter
-OPENXR_HPP_INLINE /*{projected_type }*/ operator|( /*{projected_bits_type }*/ bit0, /*{projected_bits_type }*/ bit1) {
+OPENXR_HPP_CONSTEXPR OPENXR_HPP_INLINE /*{projected_type }*/ operator|( /*{projected_bits_type }*/ bit0, /*{projected_bits_type }*/ bit1) {
     return /*{projected_type }*/( bit0 ) | bit1;
 }
 
@@ -81,7 +81,7 @@ OPENXR_HPP_INLINE /*{projected_type }*/ operator|( /*{projected_bits_type }*/ bi
 //! @brief Bitwise negation operator of a /*{projected_bits_type }*/ flag bit.
 //! @see /*{projected_bits_type }*/, /*{projected_type }*/, xr::Flags
 //# endfilter
-OPENXR_HPP_INLINE /*{projected_type }*/ operator~( /*{projected_bits_type }*/ bits) {
+OPENXR_HPP_CONSTEXPR OPENXR_HPP_INLINE /*{projected_type }*/ operator~( /*{projected_bits_type }*/ bits) {
     return ~( /*{projected_type }*/( bits ) );
 }
 
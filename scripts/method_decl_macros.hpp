@@ -105,8 +105,8 @@ Result
 /*{ shared_comments(cur_cmd, enhanced) }*/
 //# endfilter
     template </*{ enhanced.get_template_decls() }*/>
-    /*{enhanced.return_type}*/ /*{enhanced.cpp_name}*/ (
-        /*{ enhanced.get_declaration_params() | join(", ")}*/) /*{enhanced.qualifiers}*/;
+    /*{ enhanced.nodiscard }*/ /*{enhanced.return_type}*/ /*{enhanced.cpp_name}*/ (
+        /*{ enhanced.get_declaration_params() | join(", ")}*/) /*{enhanced.qualifiers}*/ /*{ enhanced.get_noexcept_spec(exceptions_allowed) }*/;
 //# if enhanced.is_two_call
 //# filter block_doxygen_comment
     /*{ enhanced_comment_intro(cur_cmd, exceptions_allowed, only_no_exceptions, hide_simple, brief, "Performs two-call idiom with a stateful allocator.") }*/
@@ -115,7 +115,7 @@ Result
     /*{ shared_comments(cur_cmd, enhanced) }*/
 //# endfilter
     template </*{ enhanced.get_template_decls(suppress_default_dispatch_arg=true) }*/>
-    /*{enhanced.return_type}*/ /*{enhanced.cpp_name}*/ (
+    /*{ enhanced.nodiscard }*/ /*{enhanced.return_type}*/ /*{enhanced.cpp_name}*/ (
         /*{ enhanced.get_declaration_params(extras=["Allocator const& vectorAllocator"], suppress_default_dispatch_arg=true) | join(", ")}*/) /*{enhanced.qualifiers}*/;
 
 //# endif
@@ -139,8 +139,8 @@ Result
 /*{ shared_comments(cur_cmd, method) }*/
 //#     endfilter
 template </*{ method.get_template_decls() }*/>
-/*{method.return_type}*/ /*{method.cpp_name}*/ (
-    /*{ method.get_declaration_params() | join(", ")}*/) /*{method.qualifiers}*/;
+/*{ method.nodiscard }*/ /*{method.return_type}*/ /*{method.cpp_name}*/ (
+    /*{ method.get_declaration_params() | join(", ")}*/) /*{method.qualifiers}*/ /*{ method.get_noexcept_spec() }*/;
 
 //#     if hide_simple
 #else  // OPENXR_HPP_DISABLE_ENHANCED_MODE
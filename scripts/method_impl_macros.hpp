@@ -115,7 +115,7 @@ OPENXR_HPP_INLINE /*{enhanced.return_type}*/ /*{enhanced.qualified_name}*/ (
 
 template </*{ enhanced.template_defns }*/>
 OPENXR_HPP_INLINE /*{enhanced.return_type}*/ /*{enhanced.qualified_name}*/ (
-    /*{ enhanced.get_definition_params() | join(", ")}*/) /*{enhanced.qualifiers}*/ {
+    /*{ enhanced.get_definition_params() | join(", ")}*/) /*{enhanced.qualifiers}*/ /*{ enhanced.get_noexcept_spec(exceptions_allowed) }*/ {
     /*{ enhanced.pre_statements | join("\n") | indent}*/
     /*{ enhanced.get_main_invoke() }*/
     /*{ enhanced.post_statements | join("\n") | indent }*/
@@ -31,7 +31,7 @@
 
 template </*{ method.template_defns }*/>
 OPENXR_HPP_INLINE /*{method.return_type}*/ /*{method.qualified_name}*/ (
-    /*{ method.get_definition_params() | join(", ")}*/) /*{ method.qualifiers }*/ {
+    /*{ method.get_definition_params() | join(", ")}*/) /*{ method.qualifiers }*/ /*{ method.get_noexcept_spec() }*/ {
     /*{ method.pre_statements | join("\n") | indent}*/
     /*{ method.get_main_invoke() | indent}*/
     /*{ method.post_statements | join("\n") | indent}*/
@@ -45,7 +45,7 @@ class Flags {
     OPENXR_HPP_CONSTEXPR Flags() : m_mask(0) {}
 
     //! Implicit constructor from a single bit
-    Flags(BitType bit) : m_mask(static_cast<MaskType>(bit)) {}
+    OPENXR_HPP_CONSTEXPR Flags(BitType bit) : m_mask(static_cast<MaskType>(bit)) {}
 
     //! Copy constructor
     Flags(Flags const &rhs) = default;
@@ -54,7 +54,7 @@ class Flags {
     Flags &operator=(Flags const &rhs) = default;
 
     //! Explicit constructor from flags value
-    explicit Flags(MaskType flags) : m_mask(flags) {}
+    OPENXR_HPP_CONSTEXPR explicit Flags(MaskType flags) : m_mask(flags) {}
 
     //! OR update operator - commonly used for combining flags
     Flags &operator|=(Flags const &rhs) {
@@ -75,56 +75,40 @@ class Flags {
     }
 
     //! OR operator, often used for combining flags.
-    Flags operator|(Flags const &rhs) const {
-        Flags result(*this);
-        result |= rhs;
-        return result;
-    }
+    OPENXR_HPP_CONSTEXPR Flags operator|(Flags const &rhs) const { return Flags(m_mask | rhs.m_mask); }
 
     //! AND operator, often used for testing the value of certain bits.
-    Flags operator&(Flags const &rhs) const {
-        Flags result(*this);
-        result &= rhs;
-        return result;
-    }
+    OPENXR_HPP_CONSTEXPR Flags operator&(Flags const &rhs) const { return Flags(m_mask & rhs.m_mask); }
 
     //! XOR operator
-    Flags operator^(Flags const &rhs) const {
-        Flags result(*this);
-        result ^= rhs;
-        return result;
-    }
+    OPENXR_HPP_CONSTEXPR Flags operator^(Flags const &rhs) const { return Flags(m_mask ^ rhs.m_mask); }
 
     //! Unary negation: true if all bits were false.
-    bool operator!() const { return !m_mask; }
+    OPENXR_HPP_CONSTEXPR bool operator!() const { return !m_mask; }
 
     //! Bitwise negation (complement) operator
-    Flags operator~() const {
-        Flags result(*this);
-        result.m_mask ^= static_cast<MaskType>(BitType::AllBits);
-        return result;
-    }
+    OPENXR_HPP_CONSTEXPR Flags operator~() const { return Flags(m_mask ^ static_cast<MaskType>(BitType::AllBits)); }
 
     //! Accessor for contained value
-    MaskType get() const noexcept { return m_mask; }
+    OPENXR_HPP_CONSTEXPR MaskType get() const noexcept { return m_mask; }
 
     //! Equality comparison
-    bool operator==(Flags const &rhs) const { return m_mask == rhs.m_mask; }
+    OPENXR_HPP_CONSTEXPR bool operator==(Flags const &rhs) const { return m_mask == rhs.m_mask; }
 
     //! Inequality comparison
-    bool operator!=(Flags const &rhs) const { return m_mask != rhs.m_mask; }
+    OPENXR_HPP_CONSTEXPR bool operator!=(Flags const &rhs) const { return m_mask != rhs.m_mask; }
 
     //! Equality comparison, mainly intended for compare to 0
-    bool operator==(int rhs) const { return m_mask == static_cast<MaskType>(rhs); }
+    OPENXR_HPP_CONSTEXPR bool operator==(int rhs) const { return m_mask == static_cast<MaskType>(rhs); }
 
     //! Inequality comparison, mainly intended for compare to 0
-    bool operator!=(int rhs) const { return m_mask != static_cast<MaskType>(rhs); }
+    OPENXR_HPP_CONSTEXPR bool operator!=(int rhs) const { return m_mask != static_cast<MaskType>(rhs); }
 
     //! Explicit bool conversion: true if any bits are true.
-    explicit operator bool() const { return !!m_mask; }
+    OPENXR_HPP_CONSTEXPR explicit operator bool() const { return !!m_mask; }
 
     //! Explicit conversion operator to the underlying mask type.
-    explicit operator MaskType() const { return m_mask; }
+    OPENXR_HPP_CONSTEXPR explicit operator MaskType() const { return m_mask; }
 
    private:
     MaskType m_mask;
@@ -141,7 +125,7 @@ class Flags {
  * @relates Flags
  */
 template <typename BitType, typename MaskType>
-Flags<BitType, MaskType> operator|(BitType bit, Flags<BitType, MaskType> const &flags) {
+OPENXR_HPP_CONSTEXPR Flags<BitType, MaskType> operator|(BitType bit, Flags<BitType, MaskType> const &flags) {
     return flags | bit;
 }
 
@@ -156,7 +140,7 @@ Flags<BitType, MaskType> operator|(BitType bit, Flags<BitType, MaskType> const &
  * @relates Flags
  */
 template <typename BitType, typename MaskType>
-Flags<BitType, MaskType> operator&(BitType bit, Flags<BitType, MaskType> const &flags) {
+OPENXR_HPP_CONSTEXPR Flags<BitType, MaskType> operator&(BitType bit, Flags<BitType, MaskType> const &flags) {
     return flags & bit;
 }
 
@@ -171,8 +155,20 @@ Flags<BitType, MaskType> operator&(BitType bit, Flags<BitType, MaskType> const &
  * @relates Flags
  */
 template <typename BitType, typename MaskType>
-Flags<BitType, MaskType> operator^(BitType bit, Flags<BitType, MaskType> const &flags) {
+OPENXR_HPP_CONSTEXPR Flags<BitType, MaskType> operator^(BitType bit, Flags<BitType, MaskType> const &flags) {
     return flags ^ bit;
 }
 
 }  // namespace OPENXR_HPP_NAMESPACE
+
+#ifndef OPENXR_HPP_DOXYGEN
+namespace std {
+//! Hash specialization, for Flags keys of unordered containers.
+template <typename BitType, typename MaskType>
+struct hash<OPENXR_HPP_NAMESPACE::Flags<BitType, MaskType>> {
+    size_t operator()(OPENXR_HPP_NAMESPACE::Flags<BitType, MaskType> const &flags) const noexcept {
+        return hash<MaskType>{}(flags.get());
+    }
+};
+}  // namespace std
+#endif  // !OPENXR_HPP_DOXYGEN
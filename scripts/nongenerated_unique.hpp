@@ -216,7 +216,8 @@ class ObjectDestroy {
    protected:
     template <typename T>
     void destroy(T t) {
-        t.destroy(*m_dispatch);
+        // Result is deliberately ignored: there is nothing useful to do with a failure during destruction.
+        static_cast<void>(t.destroy(*m_dispatch));
     }
 
    private:
@@ -29,10 +29,10 @@
 //## choose to deem waived or otherwise exclude such Section(s) of the License,
 //## but only in their entirety and only with respect to the Combined Software.
 
-//# from 'macros.hpp' import wrapperSizeStaticAssert, initializeStaticLengthString, initializeStaticLengthArray, make_spec_ref, extension_comment
+//# from 'macros.hpp' import wrapperSizeStaticAssert, make_spec_ref, extension_comment
 
 //# macro _makeDefaultConstructor(s, is_explicit, visible_members)
-        /*{ "explicit" if is_explicit }*/ /*{s.cpp_name }*/ (
+        /*{ s.constexpr_keyword if visible_members is defined }*/ /*{ "explicit" if is_explicit }*/ /*{s.cpp_name }*/ (
             /*{s.next_param_decl_with_default if s.typed_struct}*/)
 
 //#     set initializer_comma = initializers()
@@ -44,14 +44,39 @@
 //#         endif
              , /*{s.next_param_name}*/)
 //#     endif
-//#    for member in visible_members if member.name not in s.parent_fields and not is_static_length_string(member)
+//#    for member in visible_members if member.name not in s.parent_fields
+//#        if is_static_length_string(member)
+                  /*{- initializer_comma() }*/ /*{ member.name }*/{}
+//#        else
                   /*{- initializer_comma() }*/ /*{ member.name }*/{/*{ get_default_for_member(member, s.name, "") -}*/}
+//#        endif
+//#    endfor
+            {}
+//# endmacro
+
+//# macro _makeUninitializedConstructor(struct, s)
+//#    if s.is_abstract
+        /*{s.cpp_name }*/ (Uninitialized, StructureType type_) noexcept
+//#    else
+        explicit /*{s.cpp_name }*/ (Uninitialized) noexcept
+//#    endif
+//#    set initializer_comma = initializers()
+//#    if s.typed_struct
+//#        set struct_type = "type_" if s.is_abstract else s.struct_type_enum
+//#        if s.is_derived_type
+            /*{- initializer_comma() }*/ Parent(Uninitialized{}, /*{ struct_type }*/)
+//#        else
+            /*{- initializer_comma() }*/ Parent(/*{ struct_type }*/)
+//#        endif
+//#    endif
+//#    for member in struct.members if not member is cpp_hidden_member and member.name not in s.parent_fields and is_uninitializable_member(member)
+            /*{- initializer_comma() }*/ /*{ member.name }*/{Uninitialized{}}
 //#    endfor
             {}
 //# endmacro
 
 //# macro _makeFullInitializingConstructor(struct, s, visible_members, allowDefaulting)
-        /*{ s.cpp_name }*/ (
+        /*{ s.constexpr_keyword }*/ /*{ s.cpp_name }*/ (
 //#    set first_defaultable_index0 = index0_of_first_visible_defaultable_member(visible_members)
 //#    set arg_comma = joiner(", ")
                   /*%- if s.is_abstract %*/ /*{ arg_comma() }*/ StructureType type_ /*% endif -%*/
@@ -75,17 +100,20 @@
               )
 //#    endif
 
-//#    for member in visible_members if member.name not in s.parent_fields and not is_static_length_array(member)
+//#    for member in visible_members if member.name not in s.parent_fields
+//#        if is_static_length_array(member)
+              /*{- initializer_comma() }*/ /*{ member.name }*/ {}
+//#        else
               /*{- initializer_comma() }*/ /*{ member.name }*/ {/*{ member.name + "_"}*/}
+//#        endif
 //#    endfor
         {
-//#    for member in visible_members if is_static_length_array(member)
+//#    for member in visible_members if member.name not in s.parent_fields and is_static_length_array(member)
 //#         if is_static_length_string(member)
-            /*{ initializeStaticLengthString(member.name + "_", member.name, member.array_count_var) }*/
+            impl::copyStaticLengthString(/*{ member.name }*/, /*{ member.name + "_" }*/);
 //#         else
-            /*{ initializeStaticLengthArray(member.name + "_", member.name) }*/
+            impl::copyStaticLengthArray(/*{ member.name }*/, /*{ member.name + "_" }*/);
 //#         endif
-
 //#    endfor
         }
 
@@ -142,6 +170,16 @@
         /*{ _makeDefaultConstructor(s, false, visible_members) }*/
 //#     endif
 //# endif
+//# if s.is_abstract
+        //! Protected constructor leaving all members but `type` and `next` uninitialized: this type is abstract.
+//# else
+//#     filter block_doxygen_comment
+        //! @brief Constructor leaving all members but `type` and `next` uninitialized.
+        //!
+        //! For output parameters the runtime will fill in completely.
+//#     endfilter
+//# endif
+        /*{ _makeUninitializedConstructor(struct, s) }*/
 //# if s.is_abstract
     public:
 //# endif
@@ -153,8 +191,8 @@
         //! Default copy assignment
         /*{ s.cpp_name }*/& operator=(const /*{ s.cpp_name }*/& rhs) = default;
         //! Copy construct from raw
-        /*{ s.cpp_name }*/(const /*{ s.name }*/& rhs) : /*{ s.cpp_name }*/() {
-            *put() = rhs;
+        /*{ s.cpp_name }*/(const /*{ s.name }*/& rhs) : /*{ s.cpp_name }*/(Uninitialized{}) {
+            *put(false) = rhs;
         }
         //! Copy assign from raw
         /*{ s.cpp_name }*/& operator=(const /*{ s.name }*/& rhs) {
@@ -205,6 +243,44 @@
 
 //# for member in struct.members if not member is cpp_hidden_member and member.name not in s.parent_fields
         /*{ project_cppdecl(struct, member) }*/;
+//# endfor
+//# for member in struct.members if member.type != "void" and member.name not in s.parent_fields and member_count_field(struct, member)
+//#     set count_field = member_count_field(struct, member)
+//#     set accessor_suffix = member.name[0] | upper ~ member.name[1:]
+//#     set written_field = member_written_count_field(struct, member)
+//#     set span_type = "Span<std::remove_pointer<decltype(" ~ member.name ~ ")>::type>"
+//#     if written_field
+
+        //! Accessor for the elements the runtime wrote to `/*{ member.name }*/`, as a span of `/*{ written_field }*/` elements, at most `/*{ count_field }*/`, without copying.
+        /*{ span_type }*/ get/*{ accessor_suffix }*/() const noexcept {
+            return {/*{ member.name }*/, /*{ written_field }*/ < /*{ count_field }*/ ? /*{ written_field }*/ : /*{ count_field }*/};
+        }
+
+        //! Points `/*{ member.name }*/` at the elements of @p value, which must outlive their use, for the runtime to write to, and sets the capacity `/*{ count_field }*/` to their count.
+//#     elif not count_field.endswith("CapacityInput")
+
+        //! Accessor for `/*{ member.name }*/` as a span of `/*{ count_field }*/` elements, without copying.
+        /*{ span_type }*/ get/*{ accessor_suffix }*/() const noexcept {
+            return {/*{ member.name }*/, /*{ count_field }*/};
+        }
+
+        //! Points `/*{ member.name }*/` at the elements of @p value, which must outlive their use, and sets `/*{ count_field }*/` to their count.
+//#     else
+
+        //! Points `/*{ member.name }*/` at the elements of @p value, which must outlive their use, for the runtime to write to, and sets the capacity `/*{ count_field }*/` to their count.
+//#     endif
+        /*{ s.cpp_name }*/& set/*{ accessor_suffix }*/(/*{ span_type }*/ value) noexcept {
+            /*{ member.name }*/ = value.data();
+            /*{ count_field }*/ = static_cast<decltype(/*{ count_field }*/)>(value.size());
+            return *this;
+        }
+
+        //! Deleted, as `/*{ member.name }*/` would be left pointing at the elements of the list once they are destroyed.
+        /*{ s.cpp_name }*/& set/*{ accessor_suffix }*/(std::initializer_list<std::remove_cv<std::remove_pointer<decltype(/*{ member.name }*/)>::type>::type>) = delete;
+
+        //! Deleted, as `/*{ member.name }*/` would be left pointing at the elements of the temporary once it is destroyed.
+        template <typename Container, typename = typename std::enable_if<impl::is_temporary_container<Container>::value>::type>
+        /*{ s.cpp_name }*/& set/*{ accessor_suffix }*/(Container&&) = delete;
 //# endfor
     };
     /*{ wrapperSizeStaticAssert(struct.name, s.cpp_name) }*/
@@ -38,6 +38,9 @@
 
 #include <openxr/openxr.h>
 
+#include <cstddef>
+#include <functional>
+
 #ifdef OPENXR_HPP_DOXYGEN
 #include <openxr/openxr_platform.h>
 #endif
@@ -62,4 +65,17 @@ namespace OPENXR_HPP_NAMESPACE {
 
 } // namespace OPENXR_HPP_NAMESPACE
 
+#ifndef OPENXR_HPP_DOXYGEN
+namespace std {
+// Hash specializations, for atom keys of unordered containers.
+//# for raw_type in gen.dict_atoms.keys() if raw_type not in gen.skip_projection
+//#     set type = raw_type | replace("Xr", "")
+template <>
+struct hash<OPENXR_HPP_NAMESPACE::/*{ type }*/> {
+    size_t operator()(OPENXR_HPP_NAMESPACE::/*{ type }*/ const& v) const noexcept { return hash</*{ raw_type }*/>{}(v.get()); }
+};
+//# endfor
+}  // namespace std
+#endif  // !OPENXR_HPP_DOXYGEN
+
 //# include('file_footer.hpp')
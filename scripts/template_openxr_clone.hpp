@@ -0,0 +1,344 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::Arena and xr::cloneChain, for deep copying structures and their `next` chains without heap allocation.
+ *
+ * @see xr::Arena, xr::cloneChain, xr::cloneDeep
+ * @ingroup structs
+ */
+
+#include "openxr_structs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+//# macro _clone_step(struct, step)
+//#     set elem = gen.dict_structs[step.element_type] if step.element_type in gen.dict_structs else None
+//#     if elem
+/*{ protect_begin(elem, struct) }*/
+//#     endif
+//#     if step.kind == "nested" and step.is_static_array
+        for (auto& element : s./*{ step.name }*/) {
+            if (!cloneMembers(element, arena)) return false;
+        }
+//#     elif step.kind == "nested"
+        if (!cloneMembers(s./*{ step.name }*/, arena)) return false;
+//#     elif step.kind == "string"
+        if (!copyString(s./*{ step.name }*/, arena)) return false;
+//#     elif step.kind == "string_array"
+        {
+            const char** copy;
+            if (!copyArray(s./*{ step.name }*/, /*{ step.count }*/, arena, copy)) return false;
+            for (size_t i = 0; copy != nullptr && i < /*{ step.count }*/; ++i) {
+                if (!copyString(copy[i], arena)) return false;
+            }
+        }
+//#     elif step.kind == "bytes"
+        if (!copyBytes(s./*{ step.name }*/, /*{ step.count }*/, arena)) return false;
+//#     elif step.kind == "array" and step.element_fixup
+        {
+            /*{ step.element_type }*/* copy;
+            if (!copyArray(s./*{ step.name }*/, /*{ step.count }*/, arena, copy)) return false;
+            for (size_t i = 0; copy != nullptr && i < /*{ step.count }*/; ++i) {
+                if (!cloneMembers(copy[i], arena)) return false;
+            }
+        }
+//#     elif step.kind == "array"
+        if (!copyArray(s./*{ step.name }*/, /*{ step.count }*/, arena)) return false;
+//#     elif step.kind == "pointer_array"
+        {
+            /*{ step.element_type }*/ const** copy;
+            if (!copyArray(s./*{ step.name }*/, /*{ step.count }*/, arena, copy)) return false;
+            for (size_t i = 0; copy != nullptr && i < /*{ step.count }*/; ++i) {
+                /*{ step.element_type }*/* element;
+                if (!copyArray(copy[i], 1, arena, element)) return false;
+//#         if step.element_fixup
+                if (element != nullptr && !cloneMembers(*element, arena)) return false;
+//#         endif
+            }
+        }
+//#     elif step.kind == "polymorphic"
+        if (!clonePolymorphic(s./*{ step.name }*/, arena)) return false;
+//#     elif step.kind == "polymorphic_array"
+        {
+            /*{ step.element_type }*/ const** copy;
+            if (!copyArray(s./*{ step.name }*/, /*{ step.count }*/, arena, copy)) return false;
+            for (size_t i = 0; copy != nullptr && i < /*{ step.count }*/; ++i) {
+                if (!clonePolymorphic(copy[i], arena)) return false;
+            }
+        }
+//#     endif
+//#     if elem
+/*{ protect_end(elem, struct) }*/
+//#     endif
+//# endmacro
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief A bump allocator over a caller-provided buffer, used as the destination of cloneChain().
+ *
+ * Allocation just advances an offset; nothing is freed individually. Call reset() to reuse the whole buffer,
+ * e.g. once the clones made in it for a frame are no longer used.
+ *
+ * @ingroup structs
+ */
+class Arena {
+public:
+    //! Constructor: the buffer is not owned, and must outlive the arena and everything allocated from it.
+    Arena(void* buffer, size_t capacity) noexcept : m_begin(static_cast<uint8_t*>(buffer)), m_capacity(capacity) {}
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    //! Allocates @p size bytes aligned to @p alignment (a power of two), or returns nullptr and marks the arena exhausted.
+    void* allocate(size_t size, size_t alignment) noexcept {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_begin);
+        const uintptr_t aligned = (base + m_used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        const size_t start = static_cast<size_t>(aligned - base);
+        if (start > m_capacity || size > m_capacity - start) {
+            m_exhausted = true;
+            return nullptr;
+        }
+        m_used = start + size;
+        return m_begin + start;
+    }
+
+    //! Allocates uninitialized room for @p count objects of type @p T, or returns nullptr and marks the arena exhausted.
+    template <typename T>
+    T* allocateArray(size_t count) noexcept {
+        if (count > SIZE_MAX / sizeof(T)) {
+            m_exhausted = true;
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /*!
+     * @brief Frees everything allocated since used() returned @p mark, e.g. to undo a copy that failed partway.
+     *
+     * Anything allocated after @p mark must no longer be used. exhausted() is left as it is.
+     */
+    void rewind(size_t mark) noexcept {
+        if (mark < m_used) {
+            m_used = mark;
+        }
+    }
+
+    //! Makes the whole buffer available again: anything allocated before must no longer be used.
+    void reset() noexcept {
+        m_used = 0;
+        m_exhausted = false;
+    }
+
+    //! Number of bytes allocated, including alignment padding.
+    size_t used() const noexcept { return m_used; }
+
+    //! Size of the buffer.
+    size_t capacity() const noexcept { return m_capacity; }
+
+    //! True if an allocation failed since construction or the last reset().
+    bool exhausted() const noexcept { return m_exhausted; }
+
+private:
+    uint8_t* m_begin;
+    size_t m_capacity;
+    size_t m_used = 0;
+    bool m_exhausted = false;
+};
+
+namespace impl {
+    //! Copies @p count elements into the arena and points @p ptr at the copy, also returned in @p copy.
+    template <typename T>
+    OPENXR_HPP_INLINE bool copyArray(T const*& ptr, size_t count, Arena& arena, T*& copy) noexcept {
+        copy = nullptr;
+        if (ptr == nullptr || count == 0) {
+            return true;
+        }
+        copy = arena.allocateArray<T>(count);
+        if (copy == nullptr) {
+            return false;
+        }
+        memcpy(copy, ptr, sizeof(T) * count);
+        ptr = copy;
+        return true;
+    }
+
+    //! Copies @p count elements into the arena and points @p ptr at the copy.
+    template <typename T>
+    OPENXR_HPP_INLINE bool copyArray(T const*& ptr, size_t count, Arena& arena) noexcept {
+        T* copy;
+        return copyArray(ptr, count, arena, copy);
+    }
+
+    //! Copies @p count bytes into the arena and points @p ptr at the copy.
+    OPENXR_HPP_INLINE bool copyBytes(const void*& ptr, size_t count, Arena& arena) noexcept {
+        const uint8_t* bytes = static_cast<const uint8_t*>(ptr);
+        if (!copyArray(bytes, count, arena)) {
+            return false;
+        }
+        ptr = bytes;
+        return true;
+    }
+
+    //! Copies a null-terminated string into the arena and points @p str at the copy.
+    OPENXR_HPP_INLINE bool copyString(const char*& str, Arena& arena) noexcept {
+        return str == nullptr || copyArray(str, strlen(str) + 1, arena);
+    }
+
+    OPENXR_HPP_INLINE bool cloneStruct(const void*& ptr, Arena& arena) noexcept;
+
+    //! Deep copies the struct @p ptr points to, of any type derived from T, and points @p ptr at the copy.
+    template <typename T>
+    OPENXR_HPP_INLINE bool clonePolymorphic(T const*& ptr, Arena& arena) noexcept {
+        const void* untyped = ptr;
+        if (!cloneStruct(untyped, arena)) {
+            return false;
+        }
+        ptr = static_cast<T const*>(untyped);
+        return true;
+    }
+
+    //! Deep copies an output `next` chain.
+    OPENXR_HPP_INLINE bool cloneStruct(void*& ptr, Arena& arena) noexcept {
+        const void* untyped = ptr;
+        if (!cloneStruct(untyped, arena)) {
+            return false;
+        }
+        ptr = const_cast<void*>(untyped);
+        return true;
+    }
+
+    // Deep copy of what the members of a struct point to, once its bytes are copied: one overload per struct needing one.
+//# for struct in gen.cloneable_structs
+    /*{ protect_begin(struct) }*/
+    OPENXR_HPP_INLINE bool cloneMembers(/*{ struct.name }*/& s, Arena& arena) noexcept;
+    /*{ protect_end(struct) }*/
+//# endfor
+
+//# for struct in gen.cloneable_structs
+    /*{ protect_begin(struct) }*/
+    OPENXR_HPP_INLINE bool cloneMembers(/*{ struct.name }*/& s, Arena& arena) noexcept {
+//#     if is_tagged_type(struct.name)
+        if (!cloneStruct(s.next, arena)) return false;
+//#     endif
+//#     for step in clone_plan(struct)
+/*{ _clone_step(struct, step) }*/
+//#     endfor
+        return true;
+    }
+    /*{ protect_end(struct) }*/
+
+//# endfor
+
+    //! Deep copies the typed struct @p ptr points to, based on its `type`, and points @p ptr at the copy.
+    OPENXR_HPP_INLINE bool cloneStruct(const void*& ptr, Arena& arena) noexcept {
+        if (ptr == nullptr) {
+            return true;
+        }
+        switch (static_cast<StructureType>(static_cast<XrBaseInStructure const*>(ptr)->type)) {
+//# for struct in gen.cloneable_structs if is_tagged_type(struct.name)
+            /*{ protect_begin(struct) }*/
+            case /*{ project_struct(struct).struct_type_enum }*/: {
+                /*{ struct.name }*/ const* original = static_cast</*{ struct.name }*/ const*>(ptr);
+                /*{ struct.name }*/* copy;
+                if (!copyArray(original, 1, arena, copy) || !cloneMembers(*copy, arena)) {
+                    return false;
+                }
+                ptr = copy;
+                return true;
+            }
+            /*{ protect_end(struct) }*/
+//# endfor
+            default:
+                // Unknown size: it cannot be copied, and sharing it with the original would defeat the copy.
+                return false;
+        }
+    }
+}  // namespace impl
+
+/*!
+ * @brief Deep copies a `next` chain into an arena, returning the copy of its first struct.
+ *
+ * Every struct in the chain is copied, along with everything it points to through pointers to const:
+ * strings, arrays (of structs, with their own chains, and of pointers to structs, such as composition layers), and so on.
+ *
+ * The copy fails if the arena runs out of space, or if the chain holds a struct of a type unknown to this version of
+ * OpenXR-Hpp, or compiled out by its platform define, whose size is unknown. Arena::exhausted() tells the two apart.
+ * Whatever was allocated for a failed copy is freed again.
+ *
+ * @return the copy, or nullptr if @p next is nullptr or the copy failed.
+ *
+ * @ingroup structs
+ */
+OPENXR_HPP_INLINE const void* cloneChain(const void* next, Arena& arena) noexcept {
+    const size_t mark = arena.used();
+    if (!impl::cloneStruct(next, arena)) {
+        arena.rewind(mark);
+        return nullptr;
+    }
+    return next;
+}
+
+/*!
+ * @brief Deep copies a typed struct, its `next` chain and everything they point to into an arena, as with cloneChain().
+ *
+ * ```{.cpp}
+ * // render thread
+ * arena.reset();
+ * const xr::FrameEndInfo* submitted = xr::cloneDeep(frameEndInfo, arena);
+ * // hand submitted to the submit thread
+ * ```
+ *
+ * @return the copy, or nullptr if the copy failed, as described for cloneChain().
+ *
+ * @ingroup structs
+ */
+template <typename T>
+OPENXR_HPP_INLINE T const* cloneDeep(T const& s, Arena& arena) noexcept {
+    static_assert(traits::structure_type_of<T>::value != StructureType::Unknown, "cloneDeep requires a typed struct");
+    const size_t mark = arena.used();
+    const void* ptr = &s;
+    if (!impl::cloneStruct(ptr, arena)) {
+        arena.rewind(mark);
+        return nullptr;
+    }
+    return static_cast<T const*>(ptr);
+}
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
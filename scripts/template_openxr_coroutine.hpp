@@ -0,0 +1,359 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains C++20 coroutine awaitables for the frame cycle: xr::nextFrame(), xr::acquireImage() and
+ * xr::AwaitableEventPump.
+ *
+ * Only available when the compiler supports coroutines (`__cpp_impl_coroutine`): this header is not included by
+ * openxr.hpp.
+ *
+ * @ingroup utilities
+ */
+
+#include "openxr_event_pump.hpp"
+#include "openxr_handles.hpp"
+#include "openxr_structs.hpp"
+
+#if defined(__cpp_impl_coroutine) || defined(OPENXR_HPP_DOXYGEN)
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace OPENXR_HPP_NAMESPACE {
+
+#if defined(__cpp_impl_coroutine) || defined(OPENXR_HPP_DOXYGEN)
+
+namespace impl {
+/*!
+ * @brief An awaitable that makes a blocking call on an executor, then resumes the awaiting coroutine there.
+ *
+ * @p Call is a nullary callable, called once, whose result (or exception) is that of the `co_await` expression.
+ */
+template <typename Executor, typename Call>
+class BlockingCallAwaitable {
+public:
+    using result_type = decltype(std::declval<Call&>()());
+
+    BlockingCallAwaitable(Executor executor, Call call) : m_executor(std::move(executor)), m_call(std::move(call)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The job may resume and finish the coroutine, destroying this awaitable, before the executor returns.
+        Executor executor = m_executor;
+        executor([this, handle] {
+#ifdef OPENXR_HPP_NO_EXCEPTIONS
+            m_result.emplace(m_call());
+#else
+            try {
+                m_result.emplace(m_call());
+            } catch (...) {
+                m_exception = std::current_exception();
+            }
+#endif
+            handle.resume();
+        });
+    }
+
+    result_type await_resume() {
+#ifndef OPENXR_HPP_NO_EXCEPTIONS
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+#endif
+        return std::move(*m_result);
+    }
+
+private:
+    Executor m_executor;
+    Call m_call;
+    std::optional<result_type> m_result;
+#ifndef OPENXR_HPP_NO_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif
+};
+
+template <typename Executor, typename Call>
+OPENXR_HPP_INLINE BlockingCallAwaitable<Executor, Call> makeBlockingCallAwaitable(Executor executor, Call call) {
+    return {std::move(executor), std::move(call)};
+}
+}  // namespace impl
+
+/*!
+ * @brief Returns an awaitable that calls xr::Session::waitFrame on @p executor, and resumes the awaiting coroutine
+ * there with the FrameState.
+ *
+ * An executor is any copyable callable that runs the nullary callable passed to it, later, on a thread of its
+ * choosing: typically a lambda submitting it to a job system. The job blocks in xrWaitFrame for the job's duration,
+ * so the executor should have a thread to spare for it, but no thread is dedicated to frame pacing.
+ *
+ * ```{.cpp}
+ * auto executor = [&jobs](auto&& job) { jobs.submit(std::forward<decltype(job)>(job)); };
+ * for (;;) {
+ *     xr::FrameState frameState = co_await xr::nextFrame(session, executor);
+ *     session.beginFrame({});
+ *     // ... render for frameState.predictedDisplayTime
+ *     session.endFrame(frameEndInfo);
+ * }
+ * ```
+ *
+ * The `co_await` expression has the type returned by Session::waitFrame: xr::FrameState, or
+ * `xr::ResultValue<xr::FrameState>` if OPENXR_HPP_NO_EXCEPTIONS is defined. Exceptions thrown by it are rethrown
+ * in the coroutine. The dispatch is copied into the awaitable.
+ *
+ * @ingroup utilities
+ */
+template <typename Executor, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+OPENXR_HPP_INLINE auto nextFrame(Session session, Executor executor,
+                                 Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+    return impl::makeBlockingCallAwaitable(std::move(executor), [session, d = std::forward<Dispatch>(d)] {
+        return session.waitFrame(FrameWaitInfo{}, d);
+    });
+}
+
+/*!
+ * @brief Returns an awaitable that acquires the next image of @p swapchain and waits for it, for up to @p timeout, on
+ * @p executor, then resumes the awaiting coroutine there with the image index.
+ *
+ * See nextFrame() for what an executor is.
+ *
+ * The `co_await` expression is an `xr::ResultValue<uint32_t>` holding the image index and:
+ * - xr::Result::Success once the image is ready to render to,
+ * - xr::Result::TimeoutExpired if @p timeout expired first: the image is acquired, but
+ *   Swapchain::waitSwapchainImage must be called again before rendering to it,
+ * - other results of xrAcquireSwapchainImage or xrWaitSwapchainImage, if OPENXR_HPP_NO_EXCEPTIONS is defined.
+ *   Otherwise, errors are thrown as exceptions in the coroutine.
+ *
+ * ```{.cpp}
+ * uint32_t imageIndex = (co_await xr::acquireImage(swapchain, executor, xr::Duration::infinite())).value;
+ * // ... render to image imageIndex
+ * swapchain.releaseSwapchainImage({});
+ * ```
+ *
+ * @ingroup utilities
+ */
+template <typename Executor, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+OPENXR_HPP_INLINE auto acquireImage(Swapchain swapchain, Executor executor, Duration timeout,
+                                    Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+    return impl::makeBlockingCallAwaitable(
+        std::move(executor), [swapchain, timeout, d = std::forward<Dispatch>(d)]() -> ResultValue<uint32_t> {
+#ifdef OPENXR_HPP_NO_EXCEPTIONS
+            ResultValue<uint32_t> acquired = swapchain.acquireSwapchainImage(SwapchainImageAcquireInfo{}, d);
+            if (!succeeded(acquired.result)) {
+                return acquired;
+            }
+            const Result waited = swapchain.waitSwapchainImage(SwapchainImageWaitInfo{timeout}, d);
+            return {waited == Result::Success ? acquired.result : waited, acquired.value};
+#else
+            const uint32_t index = swapchain.acquireSwapchainImage(SwapchainImageAcquireInfo{}, d);
+            return {swapchain.waitSwapchainImage(SwapchainImageWaitInfo{timeout}, d), index};
+#endif
+        });
+}
+
+/*!
+ * @brief Polls events like xr::EventPump, and resumes coroutines awaiting events of their type.
+ *
+ * `co_await events.next<T>()` suspends the coroutine until an event of type @p T (e.g.
+ * xr::EventDataSessionStateChanged) is pumped, then resumes it on the executor (see nextFrame()) with a copy of the
+ * event. Each event is handed to every coroutine awaiting its type when it is pumped. If none is, the event is kept
+ * for the next to await its type, up to @p capacity events: past that, the oldest are dropped, and counted by
+ * dropped().
+ *
+ * Call pump() or drain() regularly, e.g. once per frame, from a single thread. next() may be awaited from any thread.
+ *
+ * ```{.cpp}
+ * xr::AwaitableEventPump<decltype(executor)> events{instance, executor};
+ *
+ * // In a coroutine:
+ * for (;;) {
+ *     auto changed = co_await events.next<xr::EventDataSessionStateChanged>();
+ *     // ... handle changed.state
+ * }
+ *
+ * // Once per frame:
+ * events.drain();
+ * ```
+ *
+ * Coroutines still awaiting an event when the pump is destroyed are never resumed, and a coroutine awaiting an event
+ * must not be destroyed.
+ *
+ * @ingroup utilities
+ */
+template <typename Executor>
+class AwaitableEventPump {
+    struct Waiter {
+        StructureType type;
+        void* event;
+        size_t size;
+        std::coroutine_handle<> handle;
+    };
+
+public:
+    /*!
+     * @brief Awaitable returned by next(), resuming with the next event of type @p T.
+     */
+    template <typename T>
+    class Next {
+    public:
+        explicit Next(AwaitableEventPump& events) noexcept : m_events(events) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            return m_events.wait(Waiter{traits::structure_type_of<T>::value, &m_event, sizeof(T), handle});
+        }
+
+        T await_resume() noexcept { return m_event; }
+
+    private:
+        AwaitableEventPump& m_events;
+        T m_event;
+    };
+
+    //! Constructor: the instance is not owned.
+    AwaitableEventPump(Instance instance, Executor executor, size_t capacity = 16)
+        : m_pump(instance), m_executor(std::move(executor)), m_capacity(capacity) {}
+
+    AwaitableEventPump(AwaitableEventPump const&) = delete;
+    AwaitableEventPump& operator=(AwaitableEventPump const&) = delete;
+
+    //! Returns an awaitable resuming with the next event of type @p T.
+    template <typename T>
+    Next<T> next() noexcept {
+        static_assert(std::is_base_of<EventDataBaseHeader, T>::value, "next() requires an event type");
+        return Next<T>{*this};
+    }
+
+    /*!
+     * @brief Polls events until none are pending or the budget is spent, resuming the coroutines awaiting them.
+     *
+     * Errors are reported as by EventPump::pump().
+     *
+     * @return the number of events polled.
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t pump(EventPumpBudget const& budget, Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        return m_pump.pump(Resumer{*this}, budget, std::forward<Dispatch>(d));
+    }
+
+    //! @brief Polls all pending events: see pump().
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t drain(Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        return pump(EventPumpBudget{}, std::forward<Dispatch>(d));
+    }
+
+    //! The result of the most recent call to xrPollEvent.
+    Result lastResult() const noexcept { return m_pump.lastResult(); }
+
+    //! The number of events dropped because nothing awaited them and more than the capacity were kept.
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_dropped;
+    }
+
+private:
+    struct Resumer {
+        AwaitableEventPump& events;
+        void operator()(EventDataBaseHeader const&) const { events.deliver(events.m_pump.buffer()); }
+    };
+
+    //! Takes a kept event for @p waiter if there is one, returning false, else registers it and returns true.
+    bool wait(Waiter const& waiter) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_kept.begin(); it != m_kept.end(); ++it) {
+            if (it->type == waiter.type) {
+                memcpy(waiter.event, &*it, waiter.size);
+                m_kept.erase(it);
+                return false;
+            }
+        }
+        m_waiters.push_back(waiter);
+        return true;
+    }
+
+    //! Hands @p event to the coroutines awaiting its type, or keeps it if there are none.
+    void deliver(EventDataBuffer const& event) {
+        std::vector<std::coroutine_handle<>> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_waiters.begin();
+            while (it != m_waiters.end()) {
+                if (it->type == event.type) {
+                    memcpy(it->event, &event, it->size);
+                    ready.push_back(it->handle);
+                    it = m_waiters.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            if (ready.empty()) {
+                if (m_capacity == 0) {
+                    ++m_dropped;
+                } else {
+                    if (m_kept.size() == m_capacity) {
+                        m_kept.pop_front();
+                        ++m_dropped;
+                    }
+                    m_kept.push_back(event);
+                }
+            }
+        }
+        for (std::coroutine_handle<> handle : ready) {
+            m_executor([handle] { handle.resume(); });
+        }
+    }
+
+    EventPump m_pump;
+    Executor m_executor;
+    size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::vector<Waiter> m_waiters;
+    std::deque<EventDataBuffer> m_kept;
+    uint64_t m_dropped = 0;
+};
+
+#endif  // defined(__cpp_impl_coroutine) || defined(OPENXR_HPP_DOXYGEN)
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
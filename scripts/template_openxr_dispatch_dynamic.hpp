@@ -162,7 +162,7 @@ class DispatchLoaderDynamic {
     //# for cur_cmd in sorted_cmds
     /*{ protect_begin(cur_cmd) }*/
     //! @brief Call /*{cur_cmd.name}*/, populating function pointer if required.
-    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ {
+    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ noexcept {
         //## Populate
         XrResult result = populate_(/*{cur_cmd.name | quote_string}*/, /*{make_pfn_name(cur_cmd)}*/);
         if (XR_FAILED(result)) {
@@ -174,7 +174,7 @@ class DispatchLoaderDynamic {
     }
 
     //! @brief Call /*{cur_cmd.name}*/ (const overload - does not populate function pointer)
-    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ const {
+    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ const noexcept {
         //## Cast and call
         return (reinterpret_cast</*{ make_pfn_type(cur_cmd) }*/>(/*{make_pfn_name(cur_cmd)}*/))(
             /*{ forwardCommandArgs(cur_cmd) }*/);
@@ -219,7 +219,7 @@ class DispatchLoaderDynamic {
     //! @}
    private:
     //! @brief Internal utility function to populate a function pointer if it is nullptr.
-    OPENXR_HPP_INLINE XrResult populate_(const char *function_name, PFN_xrVoidFunction &pfn) {
+    OPENXR_HPP_INLINE XrResult populate_(const char *function_name, PFN_xrVoidFunction &pfn) noexcept {
         if (pfn == nullptr) {
             // Not exactly the right error, but not sure what's better.
             if (isEmpty()) return XR_ERROR_HANDLE_INVALID;
@@ -83,7 +83,7 @@ class DispatchLoaderStatic {
 
     //# for cur_cmd in gen.core_commands
     //! @brief Call /*{cur_cmd.name}*/
-    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ const {
+    OPENXR_HPP_INLINE /*{cur_cmd.cdecl | collapse_whitespace | replace(";", "")}*/ const noexcept {
         return ::/*{cur_cmd.name}*/ (/*{ forwardCommandArgs(cur_cmd) }*/);
     }
 
@@ -46,13 +46,27 @@
  */
 
 #include <openxr/openxr.h>
+
+#include <chrono>
 //# endblock
 
+//# block extra_constructors_conversion_assign
+
+//! Explicit conversion from a std::chrono::duration, truncated to nanoseconds.
+template <typename Rep, typename Period>
+OPENXR_HPP_CONSTEXPR explicit Duration(std::chrono::duration<Rep, Period> d) noexcept
+    : val_(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) {}
+
+//# endblock extra_constructors_conversion_assign
+
 //## No validity methods
 //# block validity
 //# endblock
 
 //# block extra_methods
+//! Conversion to std::chrono::nanoseconds, the unit of XrDuration.
+OPENXR_HPP_CONSTEXPR std::chrono::nanoseconds toChrono() const noexcept { return std::chrono::nanoseconds{val_}; }
+
 //! Add a Duration to the current Duration
 Duration& operator+=(Duration d) noexcept {
     val_ += d.val_;
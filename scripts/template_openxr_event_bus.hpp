@@ -0,0 +1,384 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::EventBus, for broadcasting events polled on one thread to subscribers on others.
+ *
+ * @see xr::EventBus, xr::EventSubscription, xr::EventTypeMask
+ * @ingroup utilities
+ */
+
+#include "openxr_event_pump.hpp"
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+//# set event_types = struct_children["XrEventDataBaseHeader"] | select('in', gen.dict_structs) | reject('in', gen.skip_projection) | sort | list
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace impl {
+    //! Number of distinct event type indices: one per known event type, plus one for all unknown types.
+    constexpr uint32_t eventTypeCount = /*{ event_types | length }*/ + 1;
+
+    //! Index shared by all event types unknown to this version of OpenXR-Hpp.
+    constexpr uint32_t unknownEventTypeIndex = eventTypeCount - 1;
+
+    //! Maps an event structure type to a dense index, for use in an EventTypeMask.
+    OPENXR_HPP_INLINE uint32_t eventTypeIndex(StructureType type) noexcept {
+        switch (type) {
+//# for name in event_types
+//#     set child = gen.dict_structs[name]
+//#     set s = project_struct(child)
+            /*{ protect_begin(child) }*/
+            case /*{ s.struct_type_enum }*/:
+                return /*{ loop.index0 }*/;
+            /*{ protect_end(child) }*/
+//# endfor
+            default:
+                return unknownEventTypeIndex;
+        }
+    }
+
+    //! Number of bytes of the event buffer that hold an event of the given type.
+    OPENXR_HPP_INLINE size_t eventSize(StructureType type) noexcept {
+        switch (type) {
+//# for name in event_types
+//#     set child = gen.dict_structs[name]
+//#     set s = project_struct(child)
+            /*{ protect_begin(child) }*/
+            case /*{ s.struct_type_enum }*/:
+                return sizeof(/*{ name }*/);
+            /*{ protect_end(child) }*/
+//# endfor
+            default:
+                return sizeof(XrEventDataBuffer);
+        }
+    }
+
+    //! Compile-time counterpart of eventTypeIndex(): EventDataBaseHeader stands for all unknown event types.
+    template <typename T>
+    struct EventTypeIndex;
+
+    template <>
+    struct EventTypeIndex<EventDataBaseHeader> {
+        static constexpr uint32_t value = unknownEventTypeIndex;
+    };
+//# for name in event_types
+//#     set child = gen.dict_structs[name]
+//#     set s = project_struct(child)
+
+    /*{ protect_begin(child) }*/
+    template <>
+    struct EventTypeIndex</*{ s.cpp_name }*/> {
+        static constexpr uint32_t value = /*{ loop.index0 }*/;
+    };
+    /*{ protect_end(child) }*/
+//# endfor
+
+    //! Queue index on a cache line of its own, so the producer and consumer of a queue do not share one.
+#if defined(__cpp_aligned_new)
+    struct alignas(64) PaddedQueueIndex {
+#else
+    // Without aligned new, subscriptions are not allocated on a cache line boundary: pad on both sides instead.
+    struct PaddedQueueIndex {
+        char leading[64];
+#endif
+        std::atomic<uint32_t> value{0};
+        char padding[64 - sizeof(std::atomic<uint32_t>)];
+    };
+}  // namespace impl
+
+/*!
+ * @brief A set of event types, used to choose which events an EventSubscription receives.
+ *
+ * ```{.cpp}
+ * auto mask = xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>().add<xr::EventDataInstanceLossPending>();
+ * ```
+ *
+ * Adding xr::EventDataBaseHeader selects all event types unknown to this version of OpenXR-Hpp.
+ *
+ * @ingroup utilities
+ */
+class EventTypeMask {
+public:
+    //! Empty mask.
+    EventTypeMask() noexcept = default;
+
+    //! Mask of all event types, including unknown ones.
+    static EventTypeMask all() noexcept {
+        EventTypeMask ret;
+        ret.m_bits.set();
+        return ret;
+    }
+
+    //! Adds the event type of the projected event struct @p T.
+    template <typename T>
+    EventTypeMask& add() noexcept {
+        m_bits.set(impl::EventTypeIndex<T>::value);
+        return *this;
+    }
+
+    //! Adds an event type by its structure type.
+    EventTypeMask& add(StructureType type) noexcept {
+        m_bits.set(impl::eventTypeIndex(type));
+        return *this;
+    }
+
+    //! Whether events of this structure type are in the mask.
+    bool contains(StructureType type) const noexcept { return m_bits.test(impl::eventTypeIndex(type)); }
+
+    //! Whether events with this index (from impl::eventTypeIndex) are in the mask.
+    bool containsIndex(uint32_t index) const noexcept { return m_bits.test(index); }
+
+private:
+    std::bitset<impl::eventTypeCount> m_bits;
+};
+
+/*!
+ * @brief The receiving end of an EventBus: a bounded, lock-free single-producer/single-consumer queue of events.
+ *
+ * Obtained from EventBus::subscribe(). Exactly one thread may consume from it, using tryPop(), waitPop() or
+ * consume(), while the thread pumping the EventBus produces into it.
+ * Only the bytes of the actual event struct are copied in, not the whole 4000-byte buffer.
+ * If the queue is full, new events are dropped and counted rather than blocking the pumping thread.
+ *
+ * A consumer sleeping in waitPop() is woken only by events in its mask. The pumping thread only takes the
+ * subscription's mutex to wake a consumer that is sleeping: otherwise pushing stays lock-free.
+ *
+ * @ingroup utilities
+ */
+class EventSubscription {
+public:
+    //! Constructor: @p capacity is rounded up to a power of two. Use EventBus::subscribe() instead.
+    EventSubscription(EventTypeMask const& mask, uint32_t capacity)
+        : m_mask(mask), m_capacity(roundUpToPowerOfTwo(capacity)), m_slots(new EventDataBuffer[m_capacity]) {}
+
+    EventSubscription(EventSubscription const&) = delete;
+    EventSubscription& operator=(EventSubscription const&) = delete;
+
+    //! The event types this subscription receives.
+    EventTypeMask const& mask() const noexcept { return m_mask; }
+
+    //! Consumer: moves the oldest queued event into @p event, if any, returning whether there was one.
+    bool tryPop(EventDataBuffer& event) noexcept {
+        const uint32_t head = m_head.value.load(std::memory_order_relaxed);
+        if (head == m_tail.value.load(std::memory_order_acquire)) {
+            return false;
+        }
+        EventDataBuffer const& slot = m_slots[head & (m_capacity - 1)];
+        memcpy(&event, &slot, impl::eventSize(slot.type));
+        m_head.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * @brief Consumer: moves the oldest queued event into @p event, sleeping until one is queued or @p timeout
+     * elapses.
+     *
+     * @return whether there was an event.
+     */
+    template <typename Rep, typename Period>
+    bool waitPop(EventDataBuffer& event, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            if (tryPop(event)) {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            // Sequentially consistent with push(): either the producer sees m_sleeping, or this sees its event.
+            m_sleeping.store(true, std::memory_order_seq_cst);
+            const bool empty =
+                m_head.value.load(std::memory_order_relaxed) == m_tail.value.load(std::memory_order_seq_cst);
+            const bool woken = !empty || m_wake.wait_until(lock, deadline) == std::cv_status::no_timeout;
+            m_sleeping.store(false, std::memory_order_relaxed);
+            if (!woken) {
+                return tryPop(event);
+            }
+        }
+    }
+
+    /*!
+     * @brief Consumer: passes all queued events to @p visitor, in place, using visitEvent().
+     *
+     * @return the number of events visited.
+     */
+    template <typename Visitor>
+    uint32_t consume(Visitor&& visitor) {
+        uint32_t head = m_head.value.load(std::memory_order_relaxed);
+        const uint32_t tail = m_tail.value.load(std::memory_order_acquire);
+        const uint32_t count = tail - head;
+        for (; head != tail; ++head) {
+            visitEvent(m_slots[head & (m_capacity - 1)], visitor);
+            m_head.value.store(head + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    //! Number of events dropped because the queue was full. May be read from any thread.
+    uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    friend class EventBus;
+
+    static uint32_t roundUpToPowerOfTwo(uint32_t v) noexcept {
+        uint32_t ret = 1;
+        while (ret < v) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    //! Producer: copies the first @p size bytes of @p event into the queue, or counts it as dropped if full.
+    void push(EventDataBuffer const& event, size_t size) noexcept {
+        const uint32_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (tail - m_head.value.load(std::memory_order_acquire) == m_capacity) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        memcpy(&m_slots[tail & (m_capacity - 1)], &event, size);
+        m_tail.value.store(tail + 1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst)) {
+            // Taking the mutex orders this after the consumer starts waiting.
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_wake.notify_one();
+        }
+    }
+
+    EventTypeMask m_mask;
+    uint32_t m_capacity;
+    std::unique_ptr<EventDataBuffer[]> m_slots;
+    std::atomic<uint64_t> m_dropped{0};
+    //! Set by the consumer while it sleeps in waitPop().
+    std::atomic<bool> m_sleeping{false};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    //! Written by the consumer only.
+    impl::PaddedQueueIndex m_head;
+    //! Written by the producer only.
+    impl::PaddedQueueIndex m_tail;
+};
+
+/*!
+ * @brief Polls the events of an instance on one thread and broadcasts them to any number of subscribers.
+ *
+ * Each subscriber gets its own EventSubscription queue, and only receives the event types in its EventTypeMask:
+ * a subscriber interested only in xr::EventDataSessionStateChanged never sees anything else queued.
+ * Polling uses an EventPump, so the event buffer is not cleared between events.
+ *
+ * Subscribe from the pumping thread, or before pumping starts: the list of subscriptions is not synchronized.
+ *
+ * ```{.cpp}
+ * xr::EventBus bus{instance};
+ * xr::EventSubscription& lifecycle = bus.subscribe(xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>());
+ * // on the main thread, once per frame:
+ * bus.pump();
+ * // on the lifecycle thread, polling:
+ * lifecycle.consume([&](xr::EventDataSessionStateChanged const& e) { ... });
+ * // or sleeping until there is an event:
+ * xr::EventDataBuffer event;
+ * if (lifecycle.waitPop(event, std::chrono::milliseconds(100))) {
+ *     xr::visitEvent(event, handler);
+ * }
+ * ```
+ *
+ * @ingroup utilities
+ */
+class EventBus {
+public:
+    //! Constructor: the instance is not owned.
+    explicit EventBus(Instance instance) noexcept : m_pump(instance) {}
+
+    /*!
+     * @brief Adds a subscriber for the event types in @p mask, queueing up to @p capacity events (rounded up to a power of two).
+     *
+     * The subscription lives as long as the bus.
+     */
+    EventSubscription& subscribe(EventTypeMask const& mask, uint32_t capacity = 64) {
+        m_subscriptions.emplace_back(new EventSubscription(mask, capacity));
+        return *m_subscriptions.back();
+    }
+
+    /*!
+     * @brief Polls events within @p budget and queues each for every interested subscriber.
+     *
+     * Must only be called from one thread. Errors are reported as in EventPump::pump().
+     *
+     * @return the number of events polled.
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t pump(EventPumpBudget const& budget, Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        return m_pump.pump(Publisher{*this}, budget, std::forward<Dispatch>(d));
+    }
+
+    //! @brief Polls all pending events and queues them: see pump().
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t drain(Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        return pump(EventPumpBudget{}, std::forward<Dispatch>(d));
+    }
+
+    //! The pump used to poll events, e.g. for its EventPump::lastResult().
+    EventPump const& eventPump() const noexcept { return m_pump; }
+
+private:
+    //! Visitor called for every polled event: every event type converts to EventDataBaseHeader.
+    struct Publisher {
+        EventBus& bus;
+        void operator()(EventDataBaseHeader const&) const noexcept { bus.publish(bus.m_pump.buffer()); }
+    };
+
+    void publish(EventDataBuffer const& event) noexcept {
+        const uint32_t index = impl::eventTypeIndex(event.type);
+        const size_t size = impl::eventSize(event.type);
+        for (auto& subscription : m_subscriptions) {
+            if (subscription->m_mask.containsIndex(index)) {
+                subscription->push(event, size);
+            }
+        }
+    }
+
+    EventPump m_pump;
+    std::vector<std::unique_ptr<EventSubscription>> m_subscriptions;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
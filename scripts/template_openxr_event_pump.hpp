@@ -0,0 +1,181 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::EventPump, for draining the event queue once per frame, and xr::visitEvent.
+ *
+ * @see xr::EventPump, xr::visitEvent
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_structs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Calls the overload of @p visitor matching the type of the event in @p event.
+ *
+ * The event is passed as a reference to const of its projected type (e.g. xr::EventDataSessionStateChanged),
+ * selected with a single switch on `type`, as with xr::visit().
+ * Event types the visitor has no overload for are ignored: add an overload taking xr::EventDataBaseHeader
+ * to catch those, as well as event types unknown to this version of OpenXR-Hpp.
+ *
+ * @return true if the event type was known, false if it was passed as xr::EventDataBaseHeader because it was not.
+ *
+ * @ingroup utilities
+ */
+template <typename Visitor>
+OPENXR_HPP_INLINE bool visitEvent(EventDataBuffer const& event, Visitor&& visitor) {
+    return visit(*reinterpret_cast<EventDataBaseHeader const*>(&event), std::forward<Visitor>(visitor));
+}
+
+/*!
+ * @brief Limits on how much work a single call to EventPump::pump() may do.
+ *
+ * Both a count and a time limit may be set: pumping stops when either is reached.
+ * The time limit is checked after each event, so at least one pending event is always handled.
+ *
+ * @ingroup utilities
+ */
+struct EventPumpBudget {
+    //! No limit: handle all pending events.
+    EventPumpBudget() noexcept : maxEvents(UINT32_MAX), maxTime(std::chrono::steady_clock::duration::max()) {}
+
+    //! Handle at most @p maxEvents_ events.
+    explicit EventPumpBudget(uint32_t maxEvents_) noexcept
+        : maxEvents(maxEvents_), maxTime(std::chrono::steady_clock::duration::max()) {}
+
+    //! Stop handling events once @p maxTime_ has elapsed, or after @p maxEvents_ events.
+    template <typename Rep, typename Period>
+    explicit EventPumpBudget(std::chrono::duration<Rep, Period> maxTime_, uint32_t maxEvents_ = UINT32_MAX) noexcept
+        : maxEvents(maxEvents_), maxTime(std::chrono::duration_cast<std::chrono::steady_clock::duration>(maxTime_)) {}
+
+    uint32_t maxEvents;
+    std::chrono::steady_clock::duration maxTime;
+};
+
+/*!
+ * @brief Polls and dispatches all pending events of an instance, reusing a single event buffer.
+ *
+ * Unlike xr::Instance::pollEvent, the 4000-byte xr::EventDataBuffer is neither cleared on construction nor before each poll:
+ * only `type` and `next` are reset, as the runtime writes the rest.
+ * Each event is passed to a visitor using visitEvent().
+ *
+ * Typical use, once per frame:
+ *
+ * ```{.cpp}
+ * struct Handler {
+ *     void operator()(xr::EventDataSessionStateChanged const& e) { ... }
+ *     void operator()(xr::EventDataInstanceLossPending const& e) { ... }
+ * };
+ * eventPump.pump(Handler{}, xr::EventPumpBudget{std::chrono::microseconds(500)});
+ * ```
+ *
+ * @ingroup utilities
+ */
+class EventPump {
+public:
+    //! Constructor: the instance is not owned.
+    explicit EventPump(Instance instance) noexcept : m_instance(instance), m_buffer(Uninitialized{}) {}
+
+    /*!
+     * @brief Polls and visits events until none are pending or the budget is spent.
+     *
+     * Throws on errors (such as xr::Result::ErrorInstanceLost) unless exceptions are disabled,
+     * in which case pumping stops and the result is available from lastResult().
+     *
+     * @return the number of events visited.
+     */
+    template <typename Visitor, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t pump(Visitor&& visitor, EventPumpBudget const& budget, Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        const bool timed = budget.maxTime != std::chrono::steady_clock::duration::max();
+        const auto deadline = timed ? std::chrono::steady_clock::now() + budget.maxTime : std::chrono::steady_clock::time_point{};
+        uint32_t count = 0;
+        while (count < budget.maxEvents) {
+            if (!pollOne(d)) {
+                break;
+            }
+            visitEvent(m_buffer, visitor);
+            ++count;
+            if (timed && std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+        }
+        return count;
+    }
+
+    //! @brief Polls and visits all pending events: see pump().
+    template <typename Visitor, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    uint32_t drain(Visitor&& visitor, Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        return pump(std::forward<Visitor>(visitor), EventPumpBudget{}, std::forward<Dispatch>(d));
+    }
+
+    //! The result of the most recent call to xrPollEvent.
+    Result lastResult() const noexcept { return m_lastResult; }
+
+    //! The buffer holding the most recently polled event.
+    EventDataBuffer const& buffer() const noexcept { return m_buffer; }
+
+private:
+    //! Polls into the buffer without clearing it: returns true if it now holds an event.
+    template <typename Dispatch>
+    bool pollOne(Dispatch&& d) {
+        m_buffer.type = StructureType::EventDataBuffer;
+        m_buffer.next = nullptr;
+        m_lastResult = static_cast<Result>(d.xrPollEvent(m_instance.get(), m_buffer.put(false)));
+        if (m_lastResult == Result::Success) {
+            return true;
+        }
+#ifdef OPENXR_HPP_NO_EXCEPTIONS
+        OPENXR_HPP_ASSERT(succeeded(m_lastResult));
+#else
+        if (!succeeded(m_lastResult)) {
+            exceptions::throwResultException(m_lastResult, OPENXR_HPP_NAMESPACE_STRING "::EventPump::pump");
+        }
+#endif
+        return false;
+    }
+
+    Instance m_instance;
+    Result m_lastResult = Result::Success;
+    EventDataBuffer m_buffer;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,309 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::math::PoseExtrapolator, for predicting poses at nearby times from located poses and velocities,
+ * without locating spaces again.
+ *
+ * @see xr::math::PoseExtrapolator, xr::math::extrapolate
+ * @ingroup utilities
+ */
+
+#include "openxr_math.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+#include "openxr_structure_chain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace math {
+    //! How a PoseExtrapolator carries motion forward.
+    enum class MotionModel {
+        //! Keep moving and turning at the last located velocities.
+        ConstantVelocity,
+        //! Also keep accelerating at the rate estimated from the last two velocities.
+        ConstantAcceleration,
+    };
+
+    /*!
+     * @brief The located poses and velocities of up to @p MaxSpaces spaces, from which their poses at other times are
+     * predicted.
+     *
+     * Call update() with the result of each Space::locate, chaining a SpaceVelocity to the SpaceLocation, then
+     * predict() as often as needed. Parts of a pose whose velocity is not valid, per SpaceVelocityFlagBits, stay where
+     * they were located. Predictions are capped at half a turn of rotation.
+     *
+     * Everything is stored in structure-of-arrays form, and predicting many spaces at once uses SSE4.1 or NEON like
+     * the rest of xr::math.
+     *
+     * @ingroup math
+     */
+    template <size_t MaxSpaces>
+    class PoseExtrapolator {
+       public:
+        static constexpr size_t paddedCapacity = (MaxSpaces + 3) / 4 * 4;
+
+        PoseExtrapolator() noexcept { clear(); }
+
+        //! Forget every space.
+        void clear() noexcept {
+            for (size_t i = 0; i < paddedCapacity; ++i) {
+                reset(i);
+            }
+            m_count = 0;
+        }
+
+        /*!
+         * @brief Record where space @p index was located at @p time, and how fast it was moving: the SpaceVelocity
+         * chained to @p location, if any.
+         *
+         * @return false if @p index is out of range.
+         */
+        bool update(size_t index, SpaceLocation const& location, Time time) noexcept {
+            return update(index, location, findInChain<SpaceVelocity>(location.next), time);
+        }
+
+        /*!
+         * @brief Record where space @p index was located at @p time, and how fast it was moving, if @p velocity is not
+         * null.
+         *
+         * @return false if @p index is out of range.
+         */
+        bool update(size_t index, SpaceLocation const& location, SpaceVelocity const* velocity, Time time) noexcept {
+            if (index >= MaxSpaces) {
+                return false;
+            }
+            const bool positionValid = !!(location.locationFlags & SpaceLocationFlagBits::PositionValid);
+            const bool orientationValid = !!(location.locationFlags & SpaceLocationFlagBits::OrientationValid);
+            const bool linearValid = positionValid && velocity != nullptr &&
+                                     !!(velocity->velocityFlags & SpaceVelocityFlagBits::LinearValid);
+            const bool angularValid = orientationValid && velocity != nullptr &&
+                                      !!(velocity->velocityFlags & SpaceVelocityFlagBits::AngularValid);
+            const float elapsed = seconds(time - m_time[index]);
+
+            if (positionValid) {
+                store(m_position, index, location.pose.position);
+            }
+            if (orientationValid) {
+                m_orientation[0][index] = location.pose.orientation.x;
+                m_orientation[1][index] = location.pose.orientation.y;
+                m_orientation[2][index] = location.pose.orientation.z;
+                m_orientation[3][index] = location.pose.orientation.w;
+            }
+            updateVelocity(m_linearVelocity, m_linearAcceleration, m_linearValid, index, linearValid,
+                           linearValid ? velocity->linearVelocity : Vector3f{}, elapsed);
+            updateVelocity(m_angularVelocity, m_angularAcceleration, m_angularValid, index, angularValid,
+                           angularValid ? velocity->angularVelocity : Vector3f{}, elapsed);
+            m_time[index] = time;
+            m_locationFlags[index] = location.locationFlags;
+            if (index >= m_count) {
+                m_count = index + 1;
+            }
+            return true;
+        }
+
+        //! The pose of space @p index at @p time.
+        Posef predict(size_t index, Time time, MotionModel model = MotionModel::ConstantVelocity) const noexcept {
+            float out[7][1];
+            predictLanes<impl::ScalarLanes>(index, seconds(time - m_time[index]), model, out);
+            return {{out[3][0], out[4][0], out[5][0], out[6][0]}, {out[0][0], out[1][0], out[2][0]}};
+        }
+
+        /*!
+         * @brief The poses of all spaces at @p time, in @p poses, by index.
+         *
+         * @return The number of poses written: the smaller of size() and the size of @p poses.
+         */
+        size_t predict(Time time, Span<Posef> poses, MotionModel model = MotionModel::ConstantVelocity) const noexcept {
+            using Lanes = impl::SelectedLanes;
+            const size_t count = poses.size() < m_count ? poses.size() : m_count;
+            alignas(16) float elapsed[paddedCapacity];
+            for (size_t i = 0; i < paddedCapacity; ++i) {
+                elapsed[i] = i < count ? seconds(time - m_time[i]) : 0.f;
+            }
+            for (size_t i = 0; i < count; i += Lanes::width) {
+                alignas(16) float out[7][Lanes::width];
+                predictLanes<Lanes>(i, Lanes::load(elapsed + i), model, out);
+                for (size_t lane = 0; lane < Lanes::width && i + lane < count; ++lane) {
+                    poses[i + lane] = Posef{{out[3][lane], out[4][lane], out[5][lane], out[6][lane]},
+                                       {out[0][lane], out[1][lane], out[2][lane]}};
+                }
+            }
+            return count;
+        }
+
+        //! One more than the highest index updated.
+        size_t size() const noexcept { return m_count; }
+
+        //! The flags space @p index was last located with.
+        SpaceLocationFlags locationFlags(size_t index) const noexcept { return m_locationFlags[index]; }
+
+       private:
+        static float seconds(Duration d) noexcept { return static_cast<float>(d.get()) * 1e-9f; }
+
+        static void store(float (&arrays)[3][paddedCapacity], size_t index, Vector3f const& v) noexcept {
+            arrays[0][index] = v.x;
+            arrays[1][index] = v.y;
+            arrays[2][index] = v.z;
+        }
+
+        static void updateVelocity(float (&velocity)[3][paddedCapacity], float (&acceleration)[3][paddedCapacity],
+                                   uint32_t (&valid)[paddedCapacity], size_t index, bool nowValid,
+                                   Vector3f const& v, float elapsed) noexcept {
+            // Estimate acceleration from consecutive valid velocities.
+            if (nowValid && valid[index] != 0 && elapsed > 0.f) {
+                store(acceleration, index,
+                      {(v.x - velocity[0][index]) / elapsed, (v.y - velocity[1][index]) / elapsed,
+                       (v.z - velocity[2][index]) / elapsed});
+            } else {
+                store(acceleration, index, {});
+            }
+            store(velocity, index, v);
+            valid[index] = nowValid ? 0xffffffffu : 0u;
+        }
+
+        void reset(size_t i) noexcept {
+            for (int axis = 0; axis < 3; ++axis) {
+                m_position[axis][i] = 0.f;
+                m_linearVelocity[axis][i] = m_angularVelocity[axis][i] = 0.f;
+                m_linearAcceleration[axis][i] = m_angularAcceleration[axis][i] = 0.f;
+                m_orientation[axis][i] = 0.f;
+            }
+            m_orientation[3][i] = 1.f;
+            m_linearValid[i] = m_angularValid[i] = 0u;
+            m_time[i] = Time{};
+            if (i < MaxSpaces) {
+                m_locationFlags[i] = SpaceLocationFlags{};
+            }
+        }
+
+        //! Predict spaces @p i onwards, one per lane, @p elapsed seconds after they were located, into @p out.
+        template <typename Lanes>
+        void predictLanes(size_t i, typename Lanes::Register elapsed, MotionModel model,
+                          float (&out)[7][Lanes::width]) const noexcept {
+            using R = typename Lanes::Register;
+            const R half = Lanes::mul(elapsed, Lanes::set1(0.5f));
+
+            // Average velocities over the interval.
+            R v[3];
+            R w[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                v[axis] = Lanes::load(m_linearVelocity[axis] + i);
+                w[axis] = Lanes::load(m_angularVelocity[axis] + i);
+                if (model == MotionModel::ConstantAcceleration) {
+                    v[axis] = Lanes::add(v[axis], Lanes::mul(Lanes::load(m_linearAcceleration[axis] + i), half));
+                    w[axis] = Lanes::add(w[axis], Lanes::mul(Lanes::load(m_angularAcceleration[axis] + i), half));
+                }
+            }
+
+            const typename Lanes::Mask linearValid = Lanes::loadMask(m_linearValid + i);
+            for (int axis = 0; axis < 3; ++axis) {
+                const R p = Lanes::load(m_position[axis] + i);
+                Lanes::store(out[axis], Lanes::select(linearValid, Lanes::add(p, Lanes::mul(v[axis], elapsed)), p));
+            }
+
+            // Rotate by angle |w| elapsed about w: the half angle is theta = |w| h, with h = elapsed / 2, capped.
+            // cos(theta) and sin(theta) / theta are even, so their series need only theta squared.
+            const R speedSquared =
+                Lanes::add(Lanes::add(Lanes::mul(w[0], w[0]), Lanes::mul(w[1], w[1])), Lanes::mul(w[2], w[2]));
+            const R speed = Lanes::sqrt(Lanes::max(speedSquared, Lanes::set1(1e-30f)));
+            const R limit = Lanes::div(Lanes::set1(1.57079633f), speed);
+            const R h = Lanes::max(Lanes::min(half, limit), Lanes::sub(Lanes::set1(0.f), limit));
+            const R theta2 = Lanes::mul(speedSquared, Lanes::mul(h, h));
+            R cosine = Lanes::set1(-1.f / 3628800.f);
+            R sinc = Lanes::set1(-1.f / 39916800.f);
+            const float cosineTerms[] = {1.f / 40320.f, -1.f / 720.f, 1.f / 24.f, -1.f / 2.f, 1.f};
+            const float sincTerms[] = {1.f / 362880.f, -1.f / 5040.f, 1.f / 120.f, -1.f / 6.f, 1.f};
+            for (int term = 0; term < 5; ++term) {
+                cosine = Lanes::add(Lanes::mul(cosine, theta2), Lanes::set1(cosineTerms[term]));
+                sinc = Lanes::add(Lanes::mul(sinc, theta2), Lanes::set1(sincTerms[term]));
+            }
+            const R scale = Lanes::mul(sinc, h);
+            const R dx = Lanes::mul(w[0], scale);
+            const R dy = Lanes::mul(w[1], scale);
+            const R dz = Lanes::mul(w[2], scale);
+
+            // The angular velocity is in the base space, so the rotation applies after the located orientation.
+            const typename Lanes::Mask angularValid = Lanes::loadMask(m_angularValid + i);
+            const R qx = Lanes::load(m_orientation[0] + i);
+            const R qy = Lanes::load(m_orientation[1] + i);
+            const R qz = Lanes::load(m_orientation[2] + i);
+            const R qw = Lanes::load(m_orientation[3] + i);
+            const R rx = Lanes::add(Lanes::add(Lanes::mul(cosine, qx), Lanes::mul(dx, qw)),
+                                    Lanes::sub(Lanes::mul(dy, qz), Lanes::mul(dz, qy)));
+            const R ry = Lanes::add(Lanes::sub(Lanes::mul(cosine, qy), Lanes::mul(dx, qz)),
+                                    Lanes::add(Lanes::mul(dy, qw), Lanes::mul(dz, qx)));
+            const R rz = Lanes::add(Lanes::add(Lanes::mul(cosine, qz), Lanes::mul(dx, qy)),
+                                    Lanes::sub(Lanes::mul(dz, qw), Lanes::mul(dy, qx)));
+            const R rw = Lanes::sub(Lanes::sub(Lanes::mul(cosine, qw), Lanes::mul(dx, qx)),
+                                    Lanes::add(Lanes::mul(dy, qy), Lanes::mul(dz, qz)));
+            Lanes::store(out[3], Lanes::select(angularValid, rx, qx));
+            Lanes::store(out[4], Lanes::select(angularValid, ry, qy));
+            Lanes::store(out[5], Lanes::select(angularValid, rz, qz));
+            Lanes::store(out[6], Lanes::select(angularValid, rw, qw));
+        }
+
+        alignas(16) float m_position[3][paddedCapacity];
+        alignas(16) float m_orientation[4][paddedCapacity];
+        alignas(16) float m_linearVelocity[3][paddedCapacity];
+        alignas(16) float m_angularVelocity[3][paddedCapacity];
+        alignas(16) float m_linearAcceleration[3][paddedCapacity];
+        alignas(16) float m_angularAcceleration[3][paddedCapacity];
+        alignas(16) uint32_t m_linearValid[paddedCapacity];
+        alignas(16) uint32_t m_angularValid[paddedCapacity];
+        Time m_time[paddedCapacity];
+        SpaceLocationFlags m_locationFlags[MaxSpaces];
+        size_t m_count = 0;
+    };
+
+    /*!
+     * @brief The pose at @p time of a space located at @p locatedAt, moving at constant @p velocity.
+     *
+     * @see PoseExtrapolator
+     * @ingroup math
+     */
+    OPENXR_HPP_INLINE Posef extrapolate(SpaceLocation const& location, SpaceVelocity const& velocity, Time locatedAt,
+                                        Time time) noexcept {
+        PoseExtrapolator<1> extrapolator;
+        extrapolator.update(0, location, &velocity, locatedAt);
+        return extrapolator.predict(0, time);
+    }
+}  // namespace math
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -41,6 +41,9 @@
 
 #include <openxr/openxr.h>
 
+#include <cstddef>
+#include <functional>
+
 #ifdef OPENXR_HPP_DOXYGEN
 #include <openxr/openxr_platform.h>
 #endif
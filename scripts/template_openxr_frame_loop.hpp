@@ -0,0 +1,241 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::FrameLoop, for calling xrWaitFrame on a pacing thread of its own instead of the render thread.
+ *
+ * @see xr::FrameLoop
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_structs.hpp"
+#include "openxr_triple_buffer.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Calls xrWaitFrame on a pacing thread, and hands each FrameState to the render thread, which calls
+ * xrBeginFrame and xrEndFrame.
+ *
+ * OpenXR allows xrWaitFrame on one thread and xrBeginFrame and xrEndFrame on another. With xrWaitFrame off the render
+ * thread, the render thread can start the CPU work of the next frame while the GPU works on the last, instead of
+ * blocking in xrWaitFrame: the runtime returns the next FrameState to the pacing thread once the last frame is begun.
+ *
+ * The pacing thread calls xrWaitFrame directly into a TripleBuffer, from which acquire() or tryAcquire() take the
+ * latest FrameState without copying it under a lock; a mutex and condition variable are only used to sleep until
+ * there is one.
+ *
+ * ```{.cpp}
+ * xr::FrameLoop<> loop{session};
+ * loop.start();
+ * xr::FrameState frameState;
+ * while (loop.acquire(frameState)) {
+ *     loop.beginFrame();
+ *     // ... render for frameState.predictedDisplayTime
+ *     loop.endFrame(frameEndInfo);
+ * }
+ * // loop.lastResult() says why the pacing thread stopped.
+ * ```
+ *
+ * The runtime blocks xrWaitFrame until the frame before is begun, so the pacing thread can only exit, in stop() or
+ * the destructor, once the last frame acquired is begun, or the session ends.
+ *
+ * @ingroup utilities
+ */
+template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+class FrameLoop {
+   public:
+    //! Constructor: the session is not owned. The dispatch is copied, for use on both threads.
+    explicit FrameLoop(Session session, Dispatch d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG)
+        : m_session(session), m_dispatch(std::move(d)) {}
+
+    FrameLoop(FrameLoop const&) = delete;
+    FrameLoop& operator=(FrameLoop const&) = delete;
+
+    //! Stops the pacing thread: see stop().
+    ~FrameLoop() { stop(); }
+
+    //! Start the pacing thread, if not running.
+    void start() {
+        if (m_thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = false;
+            m_result = Result::Success;
+        }
+        m_thread = std::thread([this] { pace(); });
+    }
+
+    /*!
+     * @brief Stop the pacing thread, once its current xrWaitFrame returns, and wake acquire().
+     *
+     * A FrameState waited for but not yet acquired is dropped.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_ready.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /*!
+     * @brief Render thread: wait for the next FrameState, and copy it into @p state.
+     *
+     * If the render thread falls behind, frames it did not acquire in time are skipped, and the latest is returned.
+     *
+     * @return false if the loop was stopped, or xrWaitFrame failed: see lastResult().
+     */
+    bool acquire(FrameState& state) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready.wait(lock, [this] { return m_published != m_acquired || m_stopping; });
+            if (m_published == m_acquired) {
+                return false;
+            }
+            take();
+        }
+        state = m_frames.front();
+        return true;
+    }
+
+    //! Render thread: copy the next FrameState into @p state if there is one, without waiting.
+    bool tryAcquire(FrameState& state) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_published == m_acquired) {
+                return false;
+            }
+            take();
+        }
+        state = m_frames.front();
+        return true;
+    }
+
+    //! Render thread: call xrBeginFrame for the last FrameState acquired.
+    Result beginFrame(FrameBeginInfo const& frameBeginInfo) {
+        return static_cast<Result>(m_dispatch.xrBeginFrame(m_session.get(), frameBeginInfo.get()));
+    }
+
+    //! Render thread: call xrBeginFrame for the last FrameState acquired, with a default FrameBeginInfo.
+    Result beginFrame() { return beginFrame(FrameBeginInfo{}); }
+
+    //! Render thread: call xrEndFrame.
+    Result endFrame(FrameEndInfo const& frameEndInfo) {
+        return static_cast<Result>(m_dispatch.xrEndFrame(m_session.get(), frameEndInfo.get()));
+    }
+
+    //! The failure that stopped the pacing thread, or Result::Success.
+    Result lastResult() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_result;
+    }
+
+    //! The number of FrameState values the pacing thread has received from xrWaitFrame.
+    uint64_t framesWaited() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_published;
+    }
+
+    //! The number of FrameState values published without ever being acquired.
+    uint64_t framesSkipped() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_skipped;
+    }
+
+   private:
+    //! With the lock held: take the latest FrameState into m_frames.front().
+    void take() {
+        m_skipped += m_published - m_acquired - 1;
+        m_acquired = m_published;
+        m_frames.update();
+    }
+
+    void pace() {
+        const FrameWaitInfo frameWaitInfo;
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stopping) {
+                    return;
+                }
+            }
+            const Result result = static_cast<Result>(
+                m_dispatch.xrWaitFrame(m_session.get(), frameWaitInfo.get(), m_frames.back().put()));
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (succeeded(result)) {
+                    m_frames.publish();
+                    ++m_published;
+                } else {
+                    m_result = result;
+                    m_stopping = true;
+                }
+            }
+            m_ready.notify_all();
+            if (!succeeded(result)) {
+                return;
+            }
+        }
+    }
+
+    Session m_session;
+    Dispatch m_dispatch;
+    TripleBuffer<FrameState> m_frames;
+    std::thread m_thread;
+    //! Guards everything below, and nothing above.
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ready;
+    uint64_t m_published = 0;
+    uint64_t m_acquired = 0;
+    uint64_t m_skipped = 0;
+    bool m_stopping = false;
+    Result m_result = Result::Success;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
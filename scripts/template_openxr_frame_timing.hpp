@@ -0,0 +1,260 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::FrameTimingRecorder, for tracking display periods, missed frames and frame phase latencies,
+ * and publishing them to a metrics exporter.
+ *
+ * @see xr::FrameTimingRecorder, xr::FrameTimingSnapshot, xr::LatencyHistogram
+ * @ingroup utilities
+ */
+
+#include "openxr_structs.hpp"
+#include "openxr_triple_buffer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Counts of latencies in log-linear buckets: 1 µs wide below 8 µs, then four buckets per doubling, the last
+ * starting at 7 << 22 µs (about 29 s) and covering up to 1 << 25 µs (about 33.5 s). Longer latencies count in it too.
+ *
+ * Each bucket is at most a quarter of its lower bound wide, so percentiles are within 25%, while the whole histogram
+ * is small enough to copy every frame.
+ *
+ * @ingroup utilities
+ */
+struct LatencyHistogram {
+    static constexpr size_t bucketCount = 96;
+
+    //! The number of latencies in each bucket.
+    uint32_t counts[bucketCount];
+    //! The number of latencies in all buckets.
+    uint32_t total = 0;
+
+    LatencyHistogram() noexcept : counts{} {}
+
+    //! The bucket holding @p latency. Latencies past the last bucket go in the last bucket.
+    static size_t bucket(std::chrono::nanoseconds latency) noexcept {
+        const uint64_t us = latency.count() < 0 ? 0 : static_cast<uint64_t>(latency.count() / 1000);
+        if (us < 8) {
+            return static_cast<size_t>(us);
+        }
+        size_t exponent = 3;
+        while (exponent < 63 && (us >> (exponent + 1)) != 0) {
+            ++exponent;
+        }
+        const size_t index = 8 + (exponent - 3) * 4 + static_cast<size_t>((us >> (exponent - 2)) & 3);
+        return index < bucketCount ? index : bucketCount - 1;
+    }
+
+    //! The smallest latency in bucket @p index.
+    static std::chrono::microseconds lowerBound(size_t index) noexcept {
+        if (index < 8) {
+            return std::chrono::microseconds(static_cast<int64_t>(index));
+        }
+        const size_t exponent = 3 + (index - 8) / 4;
+        return std::chrono::microseconds(static_cast<int64_t>((4 + (index - 8) % 4) << (exponent - 2)));
+    }
+
+    //! Add a latency.
+    void add(std::chrono::nanoseconds latency) noexcept {
+        ++counts[bucket(latency)];
+        ++total;
+    }
+
+    /*!
+     * @brief The latency below which @p fraction of latencies fall, as the upper bound of the bucket holding it.
+     *
+     * @return Zero if the histogram is empty.
+     */
+    std::chrono::microseconds percentile(double fraction) const noexcept {
+        if (total == 0) {
+            return std::chrono::microseconds(0);
+        }
+        const double rank = fraction * static_cast<double>(total);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucketCount; ++i) {
+            seen += counts[i];
+            if (static_cast<double>(seen) >= rank && counts[i] != 0) {
+                return i + 1 < bucketCount ? lowerBound(i + 1) : lowerBound(i);
+            }
+        }
+        return lowerBound(bucketCount - 1);
+    }
+};
+
+/*!
+ * @brief Frame timing statistics, as published by FrameTimingRecorder.
+ *
+ * @ingroup utilities
+ */
+struct FrameTimingSnapshot {
+    //! The number of frames waited for.
+    uint64_t frameCount = 0;
+    //! Display periods skipped between consecutive frames: frames the application did not present in time.
+    uint64_t missedFrames = 0;
+    //! Frames predicted for the same display period as the frame before, or an earlier one.
+    uint64_t duplicatedFrames = 0;
+    //! The number of times the predicted display period changed, e.g. with the display refresh rate.
+    uint64_t periodChanges = 0;
+    //! The predicted display time of the latest frame.
+    Time predictedDisplayTime;
+    //! The predicted display period of the latest frame.
+    Duration predictedDisplayPeriod{0};
+    //! From xrWaitFrame returning to xrBeginFrame, over the recorder's window of recent frames.
+    LatencyHistogram waitToBegin;
+    //! From xrBeginFrame to xrEndFrame, over the recorder's window of recent frames.
+    LatencyHistogram beginToEnd;
+};
+
+/*!
+ * @brief Records the timing of each frame from FrameState and a monotonic clock, and publishes
+ * FrameTimingSnapshot values for a metrics exporter on another thread.
+ *
+ * On the frame thread, call frameWaited() with the FrameState returned by Session::waitFrame, then frameBegun() and
+ * frameEnded() after Session::beginFrame and Session::endFrame. Each frameEnded() publishes a snapshot through a
+ * TripleBuffer, which the exporter reads with snapshot(): neither thread ever waits for the other.
+ *
+ * A frame whose predicted display time is more than one display period after the previous frame's counts the
+ * periods in between as missed; one at or before the previous frame's counts as duplicated. Latency histograms
+ * cover the last @p WindowFrames frames.
+ *
+ * ```{.cpp}
+ * xr::FrameTimingRecorder<> timing;
+ * // Frame thread:
+ * xr::FrameState frameState = session.waitFrame({});
+ * timing.frameWaited(frameState);
+ * session.beginFrame({});
+ * timing.frameBegun();
+ * session.endFrame(frameEndInfo);
+ * timing.frameEnded();
+ * // Exporter thread:
+ * xr::FrameTimingSnapshot const& stats = timing.snapshot();
+ * ```
+ *
+ * @ingroup utilities
+ */
+template <size_t WindowFrames = 256>
+class FrameTimingRecorder {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    //! Frame thread: record the FrameState returned by xrWaitFrame at @p now.
+    void frameWaited(FrameState const& state, Clock::time_point now = Clock::now()) noexcept {
+        FrameTimingSnapshot& current = m_current;
+        const Duration period = state.predictedDisplayPeriod;
+        if (current.frameCount != 0) {
+            const Duration elapsed = state.predictedDisplayTime - current.predictedDisplayTime;
+            if (elapsed.get() <= 0) {
+                ++current.duplicatedFrames;
+            } else if (period.get() > 0) {
+                // Round to whole periods, so jitter in the predicted display time doesn't count.
+                const int64_t periods = (elapsed.get() + period.get() / 2) / period.get();
+                if (periods > 1) {
+                    current.missedFrames += static_cast<uint64_t>(periods - 1);
+                }
+            }
+            if (period != current.predictedDisplayPeriod) {
+                ++current.periodChanges;
+            }
+        }
+        ++current.frameCount;
+        current.predictedDisplayTime = state.predictedDisplayTime;
+        current.predictedDisplayPeriod = period;
+        m_waited = now;
+    }
+
+    //! Frame thread: record that xrBeginFrame was called at @p now.
+    void frameBegun(Clock::time_point now = Clock::now()) noexcept {
+        m_waitToBegin.add(m_current.waitToBegin, now - m_waited);
+        m_begun = now;
+    }
+
+    //! Frame thread: record that xrEndFrame was called at @p now, and publish a snapshot.
+    void frameEnded(Clock::time_point now = Clock::now()) noexcept {
+        m_beginToEnd.add(m_current.beginToEnd, now - m_begun);
+        m_published.back() = m_current;
+        m_published.publish();
+    }
+
+    //! Frame thread: the statistics so far, including any not yet published.
+    FrameTimingSnapshot const& current() const noexcept { return m_current; }
+
+    //! Exporter thread: the latest published snapshot. Only one thread may call this.
+    FrameTimingSnapshot const& snapshot() noexcept {
+        m_published.update();
+        return m_published.front();
+    }
+
+   private:
+    //! Which bucket of a histogram each of the last WindowFrames latencies went into, to remove them as they age.
+    class Window {
+        static_assert(LatencyHistogram::bucketCount <= 256, "Bucket indices are stored as uint8_t");
+
+       public:
+        void add(LatencyHistogram& histogram, Clock::duration latency) noexcept {
+            if (m_size == WindowFrames) {
+                --histogram.counts[m_buckets[m_next]];
+                --histogram.total;
+            } else {
+                ++m_size;
+            }
+            const size_t bucket = LatencyHistogram::bucket(latency);
+            m_buckets[m_next] = static_cast<uint8_t>(bucket);
+            ++histogram.counts[bucket];
+            ++histogram.total;
+            m_next = (m_next + 1) % WindowFrames;
+        }
+
+       private:
+        uint8_t m_buckets[WindowFrames] = {};
+        size_t m_next = 0;
+        size_t m_size = 0;
+    };
+
+    FrameTimingSnapshot m_current;
+    Window m_waitToBegin;
+    Window m_beginToEnd;
+    Clock::time_point m_waited;
+    Clock::time_point m_begun;
+    TripleBuffer<FrameTimingSnapshot> m_published;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -49,6 +49,7 @@
 #include "openxr_flags.hpp"
 #include "openxr_handles_forward.hpp"
 #include "openxr_structs_forward.hpp"
+#include "openxr_span.hpp"
 #include "openxr_time.hpp"
 #include "openxr_dispatch_traits.hpp"
 
@@ -58,6 +59,10 @@
 #include <openxr/openxr_platform.h>
 #endif
 
+#include <cstddef>
+#include <functional>
+#include <utility>
+
 #ifndef OPENXR_HPP_DISABLE_ENHANCED_MODE
 #include <vector>
 #endif  // !OPENXR_HPP_DISABLE_ENHANCED_MODE
@@ -74,6 +79,14 @@
 #endif
 #endif  // !OPENXR_HPP_TYPESAFE_EXPLICIT
 
+#if !defined(OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS)
+#if defined(OPENXR_HPP_NO_EXCEPTIONS)
+#define OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS(...) noexcept(__VA_ARGS__)
+#else
+#define OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS(...)
+#endif
+#endif  // !OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+
 #ifdef OPENXR_HPP_DOXYGEN
 #define OPENXR_HPP_NO_DEFAULT_DISPATCH
 #define OPENXR_HPP_NO_SMART_HANDLE
@@ -179,6 +192,27 @@
  * @ingroup config
  */
 
+/*!
+ * @def OPENXR_HPP_NODISCARD
+ * @brief Attribute applied to every wrapper that returns a Result, a value, or a handle.
+ *
+ * Defaults to `[[nodiscard]]` when compiling as C++17 or newer, and to nothing otherwise.
+ * Define it (possibly to nothing) before including OpenXR-Hpp to override.
+ *
+ * @ingroup config
+ */
+
+/*!
+ * @def OPENXR_HPP_NOEXCEPT_WHEN_NO_EXCEPTIONS
+ * @brief Implementation detail: exception specification of wrappers that only throw if exceptions are enabled.
+ *
+ * Expands to `noexcept(...)` with its arguments if `OPENXR_HPP_NO_EXCEPTIONS` is defined, and to nothing otherwise.
+ * Wrappers that never throw on error are marked noexcept whenever the dispatch entry point they call is.
+ *
+ * @see OPENXR_HPP_NO_EXCEPTIONS
+ * @ingroup config
+ */
+
 #ifndef OPENXR_HPP_NO_DEFAULT_DISPATCH
 
 #if !defined(XR_NO_PROTOTYPES) && !defined(OPENXR_HPP_DEFAULT_CORE_DISPATCHER) && !defined(OPENXR_HPP_DEFAULT_CORE_DISPATCHER_TYPE)
@@ -252,4 +286,19 @@ using string_with_allocator = std::basic_string<char, std::char_traits<char>, Al
 
 }  // namespace OPENXR_HPP_NAMESPACE
 
+#ifndef OPENXR_HPP_DOXYGEN
+namespace std {
+// Hash specializations, for handle keys of unordered containers.
+//# for handle in gen.api_handles
+//#     set shortname = project_type_name(handle.name)
+/*{ protect_begin(handle) }*/
+template <>
+struct hash<OPENXR_HPP_NAMESPACE::/*{ shortname }*/> {
+    size_t operator()(OPENXR_HPP_NAMESPACE::/*{ shortname }*/ const& h) const noexcept { return hash</*{ handle.name }*/>{}(h.get()); }
+};
+/*{ protect_end(handle) }*/
+//# endfor
+}  // namespace std
+#endif  // !OPENXR_HPP_DOXYGEN
+
 //# include('file_footer.hpp')
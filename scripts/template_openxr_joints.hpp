@@ -0,0 +1,323 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::math::JointBatch, for transforming arrays of joint locations, such as hand or body tracking
+ * results, in structure-of-arrays form.
+ *
+ * @see xr::math::JointBatch, xr::math::transformJoints, xr::math::computeBones
+ * @ingroup utilities
+ */
+
+#include "openxr_math.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace math {
+    /*!
+     * @brief The poses of up to @p MaxJoints joints, one array per component, along with which of them are valid.
+     *
+     * Arrays are padded to a multiple of four and aligned, so kernels can process four joints at a time. Padding
+     * joints are never valid.
+     *
+     * @see loadJoints, storeJoints, transformJoints, computeBones
+     * @ingroup math
+     */
+    template <size_t MaxJoints>
+    struct JointBatch {
+        static constexpr size_t capacity = MaxJoints;
+        static constexpr size_t paddedCapacity = (MaxJoints + 3) / 4 * 4;
+
+        alignas(16) float positionX[paddedCapacity];
+        alignas(16) float positionY[paddedCapacity];
+        alignas(16) float positionZ[paddedCapacity];
+        alignas(16) float orientationX[paddedCapacity];
+        alignas(16) float orientationY[paddedCapacity];
+        alignas(16) float orientationZ[paddedCapacity];
+        alignas(16) float orientationW[paddedCapacity];
+        //! All bits set for valid joints, zero otherwise.
+        alignas(16) uint32_t valid[paddedCapacity];
+        //! The number of joints loaded.
+        size_t count = 0;
+
+        //! The pose of joint @p i.
+        Posef pose(size_t i) const noexcept {
+            return {{orientationX[i], orientationY[i], orientationZ[i], orientationW[i]},
+                    {positionX[i], positionY[i], positionZ[i]}};
+        }
+
+        bool isValid(size_t i) const noexcept { return valid[i] != 0; }
+    };
+
+    /*!
+     * @brief Vectors from each joint's parent to the joint, and their lengths, as computed by computeBones.
+     *
+     * @ingroup math
+     */
+    template <size_t MaxJoints>
+    struct BoneBatch {
+        static constexpr size_t paddedCapacity = JointBatch<MaxJoints>::paddedCapacity;
+
+        alignas(16) float x[paddedCapacity];
+        alignas(16) float y[paddedCapacity];
+        alignas(16) float z[paddedCapacity];
+        alignas(16) float length[paddedCapacity];
+        //! All bits set where both the joint and its parent are valid, zero otherwise. Other bones are all zero.
+        alignas(16) uint32_t valid[paddedCapacity];
+        size_t count = 0;
+    };
+
+    namespace impl {
+        template <typename Lanes, size_t MaxJoints>
+        void transformJoints(Posef const& pose, JointBatch<MaxJoints>& joints) noexcept {
+            using R = typename Lanes::Register;
+            const R ux = Lanes::set1(pose.orientation.x);
+            const R uy = Lanes::set1(pose.orientation.y);
+            const R uz = Lanes::set1(pose.orientation.z);
+            const R uw = Lanes::set1(pose.orientation.w);
+            const R offsetX = Lanes::set1(pose.position.x);
+            const R offsetY = Lanes::set1(pose.position.y);
+            const R offsetZ = Lanes::set1(pose.position.z);
+            const R two = Lanes::set1(2.f);
+            for (size_t i = 0; i < joints.count; i += Lanes::width) {
+                const typename Lanes::Mask valid = Lanes::loadMask(joints.valid + i);
+
+                // position = offset + v + w t + u x t, where t = 2 u x v
+                const R vx = Lanes::load(joints.positionX + i);
+                const R vy = Lanes::load(joints.positionY + i);
+                const R vz = Lanes::load(joints.positionZ + i);
+                const R tx = Lanes::mul(two, Lanes::sub(Lanes::mul(uy, vz), Lanes::mul(uz, vy)));
+                const R ty = Lanes::mul(two, Lanes::sub(Lanes::mul(uz, vx), Lanes::mul(ux, vz)));
+                const R tz = Lanes::mul(two, Lanes::sub(Lanes::mul(ux, vy), Lanes::mul(uy, vx)));
+                const R dx = Lanes::add(Lanes::mul(uw, tx), Lanes::sub(Lanes::mul(uy, tz), Lanes::mul(uz, ty)));
+                const R px = Lanes::add(Lanes::add(offsetX, vx), dx);
+                const R dy = Lanes::add(Lanes::mul(uw, ty), Lanes::sub(Lanes::mul(uz, tx), Lanes::mul(ux, tz)));
+                const R py = Lanes::add(Lanes::add(offsetY, vy), dy);
+                const R dz = Lanes::add(Lanes::mul(uw, tz), Lanes::sub(Lanes::mul(ux, ty), Lanes::mul(uy, tx)));
+                const R pz = Lanes::add(Lanes::add(offsetZ, vz), dz);
+                Lanes::store(joints.positionX + i, Lanes::select(valid, px, vx));
+                Lanes::store(joints.positionY + i, Lanes::select(valid, py, vy));
+                Lanes::store(joints.positionZ + i, Lanes::select(valid, pz, vz));
+
+                // orientation = pose.orientation * orientation
+                const R qx = Lanes::load(joints.orientationX + i);
+                const R qy = Lanes::load(joints.orientationY + i);
+                const R qz = Lanes::load(joints.orientationZ + i);
+                const R qw = Lanes::load(joints.orientationW + i);
+                const R rx = Lanes::add(Lanes::add(Lanes::mul(uw, qx), Lanes::mul(ux, qw)),
+                                        Lanes::sub(Lanes::mul(uy, qz), Lanes::mul(uz, qy)));
+                const R ry = Lanes::add(Lanes::sub(Lanes::mul(uw, qy), Lanes::mul(ux, qz)),
+                                        Lanes::add(Lanes::mul(uy, qw), Lanes::mul(uz, qx)));
+                const R rz = Lanes::add(Lanes::add(Lanes::mul(uw, qz), Lanes::mul(ux, qy)),
+                                        Lanes::sub(Lanes::mul(uz, qw), Lanes::mul(uy, qx)));
+                const R rw = Lanes::sub(Lanes::sub(Lanes::mul(uw, qw), Lanes::mul(ux, qx)),
+                                        Lanes::add(Lanes::mul(uy, qy), Lanes::mul(uz, qz)));
+                Lanes::store(joints.orientationX + i, Lanes::select(valid, rx, qx));
+                Lanes::store(joints.orientationY + i, Lanes::select(valid, ry, qy));
+                Lanes::store(joints.orientationZ + i, Lanes::select(valid, rz, qz));
+                Lanes::store(joints.orientationW + i, Lanes::select(valid, rw, qw));
+            }
+        }
+
+        template <typename Lanes, size_t MaxJoints>
+        bool computeBones(JointBatch<MaxJoints> const& joints, Span<const uint32_t> parents,
+                          BoneBatch<MaxJoints>& bones) noexcept {
+            if (parents.size() != joints.count) {
+                return false;
+            }
+            // Gather the parents, then compute every bone at once.
+            alignas(16) float parentX[JointBatch<MaxJoints>::paddedCapacity];
+            alignas(16) float parentY[JointBatch<MaxJoints>::paddedCapacity];
+            alignas(16) float parentZ[JointBatch<MaxJoints>::paddedCapacity];
+            for (size_t i = 0; i < joints.count; ++i) {
+                const uint32_t parent = parents[i];
+                if (parent >= joints.count) {
+                    return false;
+                }
+                parentX[i] = joints.positionX[parent];
+                parentY[i] = joints.positionY[parent];
+                parentZ[i] = joints.positionZ[parent];
+                bones.valid[i] = joints.valid[i] & joints.valid[parent];
+            }
+            for (size_t i = joints.count; i < JointBatch<MaxJoints>::paddedCapacity; ++i) {
+                parentX[i] = parentY[i] = parentZ[i] = 0.f;
+                bones.valid[i] = 0;
+            }
+
+            using R = typename Lanes::Register;
+            const R zero = Lanes::set1(0.f);
+            for (size_t i = 0; i < joints.count; i += Lanes::width) {
+                const typename Lanes::Mask valid = Lanes::loadMask(bones.valid + i);
+                const R x = Lanes::sub(Lanes::load(joints.positionX + i), Lanes::load(parentX + i));
+                const R y = Lanes::sub(Lanes::load(joints.positionY + i), Lanes::load(parentY + i));
+                const R z = Lanes::sub(Lanes::load(joints.positionZ + i), Lanes::load(parentZ + i));
+                const R lengthSquared = Lanes::add(Lanes::add(Lanes::mul(x, x), Lanes::mul(y, y)), Lanes::mul(z, z));
+                const R length = Lanes::sqrt(lengthSquared);
+                Lanes::store(bones.x + i, Lanes::select(valid, x, zero));
+                Lanes::store(bones.y + i, Lanes::select(valid, y, zero));
+                Lanes::store(bones.z + i, Lanes::select(valid, z, zero));
+                Lanes::store(bones.length + i, Lanes::select(valid, length, zero));
+            }
+            bones.count = joints.count;
+            return true;
+        }
+    }  // namespace impl
+
+    /*!
+     * @addtogroup math
+     * @{
+     */
+
+    /*!
+     * @brief Copy joint locations into @p joints, in structure-of-arrays form.
+     *
+     * @p JointLocation may be const. Works with any location struct that has `locationFlags` and `pose` members,
+     * such as HandJointLocationEXT and BodyJointLocationFB. A joint is valid if it has all of @p required.
+     *
+     * @return false, leaving @p joints empty, if there are more than @p MaxJoints locations.
+     */
+    template <typename JointLocation, size_t MaxJoints>
+    bool loadJoints(Span<JointLocation> locations, JointBatch<MaxJoints>& joints,
+                    SpaceLocationFlags required = SpaceLocationFlagBits::OrientationValid |
+                                                  SpaceLocationFlagBits::PositionValid) noexcept {
+        joints.count = 0;
+        if (locations.size() > MaxJoints) {
+            return false;
+        }
+        for (size_t i = 0; i < locations.size(); ++i) {
+            const JointLocation& location = locations[i];
+            joints.positionX[i] = location.pose.position.x;
+            joints.positionY[i] = location.pose.position.y;
+            joints.positionZ[i] = location.pose.position.z;
+            joints.orientationX[i] = location.pose.orientation.x;
+            joints.orientationY[i] = location.pose.orientation.y;
+            joints.orientationZ[i] = location.pose.orientation.z;
+            joints.orientationW[i] = location.pose.orientation.w;
+            joints.valid[i] = (location.locationFlags & required) == required ? 0xffffffffu : 0u;
+        }
+        // Identity padding, so kernels never see garbage.
+        for (size_t i = locations.size(); i < JointBatch<MaxJoints>::paddedCapacity; ++i) {
+            joints.positionX[i] = joints.positionY[i] = joints.positionZ[i] = 0.f;
+            joints.orientationX[i] = joints.orientationY[i] = joints.orientationZ[i] = 0.f;
+            joints.orientationW[i] = 1.f;
+            joints.valid[i] = 0u;
+        }
+        joints.count = locations.size();
+        return true;
+    }
+
+    /*!
+     * @brief Copy the poses of valid joints back into @p locations, leaving everything else untouched.
+     *
+     * @p locations should be the array @p joints was loaded from.
+     */
+    template <typename JointLocation, size_t MaxJoints>
+    void storeJoints(JointBatch<MaxJoints> const& joints, Span<JointLocation> locations) noexcept {
+        const size_t count = locations.size() < joints.count ? locations.size() : joints.count;
+        for (size_t i = 0; i < count; ++i) {
+            if (joints.isValid(i)) {
+                locations[i].pose = joints.pose(i);
+            }
+        }
+    }
+
+    /*!
+     * @brief Transform every valid joint by @p pose, as compose(pose, joint) would.
+     *
+     * Use it to move joints located in one space into another, given the pose of the first space in the second.
+     */
+    template <size_t MaxJoints>
+    void transformJoints(Posef const& pose, JointBatch<MaxJoints>& joints) noexcept {
+        impl::transformJoints<impl::SelectedLanes>(pose, joints);
+    }
+
+    /*!
+     * @brief Compute the vector from each joint's parent to the joint, and its length.
+     *
+     * @p parents holds the index of each joint's parent; a root joint is its own parent, giving a zero bone.
+     * handJointParents() describes the joints of XR_EXT_hand_tracking.
+     *
+     * @return false if @p parents is not the size of @p joints, or refers to a joint that does not exist.
+     */
+    template <size_t MaxJoints>
+    bool computeBones(JointBatch<MaxJoints> const& joints, Span<const uint32_t> parents,
+                      BoneBatch<MaxJoints>& bones) noexcept {
+        return impl::computeBones<impl::SelectedLanes>(joints, parents, bones);
+    }
+
+    /*!
+     * @brief The parent of each joint of XR_HAND_JOINT_SET_DEFAULT_EXT, for computeBones.
+     *
+     * The wrist is the root, and the palm hangs off it.
+     */
+    OPENXR_HPP_INLINE Span<const uint32_t> handJointParents() noexcept {
+        static const uint32_t parents[] = {
+            1,                     // palm
+            1,                     // wrist
+            1,  2,  3,  4,         // thumb
+            1,  6,  7,  8,  9,     // index
+            1,  11, 12, 13, 14,    // middle
+            1,  16, 17, 18, 19,    // ring
+            1,  21, 22, 23, 24,    // little
+        };
+        return parents;
+    }
+
+    //! @}
+
+    namespace scalar {
+        //! transformJoints, one joint at a time.
+        template <size_t MaxJoints>
+        void transformJoints(Posef const& pose, JointBatch<MaxJoints>& joints) noexcept {
+            impl::transformJoints<impl::ScalarLanes>(pose, joints);
+        }
+
+        //! computeBones, one joint at a time.
+        template <size_t MaxJoints>
+        bool computeBones(JointBatch<MaxJoints> const& joints, Span<const uint32_t> parents,
+                          BoneBatch<MaxJoints>& bones) noexcept {
+            return impl::computeBones<impl::ScalarLanes>(joints, parents, bones);
+        }
+    }  // namespace scalar
+}  // namespace math
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
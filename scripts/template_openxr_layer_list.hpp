@@ -0,0 +1,168 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::LayerList, for submitting composition layers without building an array of pointers each frame.
+ *
+ * @see xr::LayerList, xr::endFrame
+ * @ingroup utilities
+ */
+
+#include "openxr_clone.hpp"
+#include "openxr_handles.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Composition layers of different types, stored inline, along with the array of pointers to them xrEndFrame takes.
+ *
+ * Layers are copied into a fixed-size buffer inside the list, in submission order, along with their `next` chains
+ * and the structs they point to, so none of those need to outlive the list. Layers whose chains hold a struct of a
+ * type cloneDeep() cannot copy are rejected rather than left pointing at the original. The pointers add() returns
+ * stay valid until clear(), so a list can be built once and reused from frame to frame,
+ * updating only what changes, such as poses and swapchain image indices.
+ *
+ * ```{.cpp}
+ * xr::LayerList<> layers;
+ * xr::CompositionLayerProjection* projection = layers.addProjection(xr::CompositionLayerProjection{{}, space, 0, nullptr}, views);
+ * xr::CompositionLayerQuad* hud = layers.add(hudQuad);
+ * // each frame
+ * for (xr::CompositionLayerProjectionView& view : layers.projectionViews(projection)) { ... }
+ * hud->subImage.imageArrayIndex = hudImageIndex;
+ * xr::endFrame(session, xr::FrameEndInfo{displayTime, xr::EnvironmentBlendMode::Opaque, 0, nullptr}, layers);
+ * ```
+ *
+ * @tparam MaxLayers the maximum number of layers
+ * @tparam BufferSize the size of the buffer holding the layers and their projection views, in bytes
+ *
+ * @ingroup utilities
+ */
+template <size_t MaxLayers = 16, size_t BufferSize = 4096>
+class LayerList {
+public:
+    LayerList() noexcept : m_arena(m_buffer, BufferSize) {}
+
+    // The layers point into the list itself.
+    LayerList(LayerList const&) = delete;
+    LayerList& operator=(LayerList const&) = delete;
+
+    /*!
+     * @brief Appends a deep copy of @p layer, made with cloneDeep(): its `next` chain and what it points to too.
+     *
+     * Returns a pointer to the copy, or nullptr if the list is full, if the buffer is out of space, or if the chain holds
+     * a struct of an unknown type. A layer that does not fit leaves no trace: later, smaller layers may still fit.
+     */
+    template <typename T>
+    T* add(T const& layer) noexcept {
+        static_assert(std::is_base_of<CompositionLayerBaseHeader, T>::value, "only composition layers can be added");
+        if (m_count == MaxLayers) {
+            return nullptr;
+        }
+        // The copy is in our buffer, so it is ours to modify. A failed copy frees what it allocated.
+        T* copy = const_cast<T*>(cloneDeep(layer, m_arena));
+        if (copy == nullptr) {
+            return nullptr;
+        }
+        m_layers[m_count++] = copy;
+        return copy;
+    }
+
+    /*!
+     * @brief Appends a deep copy of a projection layer and of its @p views, pointing the layer at the copied views.
+     *
+     * The `views` and `viewCount` of @p layer are ignored. Returns a pointer to the layer, or nullptr as add() does.
+     */
+    CompositionLayerProjection* addProjection(CompositionLayerProjection layer,
+                                              Span<const CompositionLayerProjectionView> views) noexcept {
+        layer.setViews(views);
+        return add(layer);
+    }
+
+    //! The views of a projection layer added with addProjection(), to update in place.
+    static Span<CompositionLayerProjectionView> projectionViews(CompositionLayerProjection* layer) noexcept {
+        return {const_cast<CompositionLayerProjectionView*>(layer->views), layer->viewCount};
+    }
+
+    //! Removes all layers, invalidating the pointers to them.
+    void clear() noexcept {
+        m_count = 0;
+        m_arena.reset();
+    }
+
+    //! The layers, in submission order, as FrameEndInfo::setLayers() takes them.
+    Span<const CompositionLayerBaseHeader* const> layers() const noexcept { return {m_layers, m_count}; }
+
+    //! Number of layers.
+    size_t size() const noexcept { return m_count; }
+
+    //! True if there are no layers.
+    bool empty() const noexcept { return m_count == 0; }
+
+    //! Maximum number of layers.
+    static OPENXR_HPP_CONSTEXPR size_t capacity() noexcept { return MaxLayers; }
+
+private:
+    alignas(16) unsigned char m_buffer[BufferSize];
+    Arena m_arena;
+    const CompositionLayerBaseHeader* m_layers[MaxLayers];
+    size_t m_count = 0;
+};
+
+/*!
+ * @brief Calls Session::endFrame() with the layers of a LayerList, without building an array of pointers.
+ *
+ * The `layers` and `layerCount` of @p frameEndInfo are ignored. Returns whatever Session::endFrame() returns.
+ *
+ * @relates LayerList
+ * @ingroup utilities
+ */
+template <size_t MaxLayers, size_t BufferSize, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+OPENXR_HPP_INLINE auto endFrame(Session session,
+                                FrameEndInfo frameEndInfo,
+                                LayerList<MaxLayers, BufferSize> const& layers,
+                                Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG)
+    -> decltype(session.endFrame(frameEndInfo, std::forward<Dispatch>(d))) {
+    frameEndInfo.setLayers(layers.layers());
+    return session.endFrame(frameEndInfo, std::forward<Dispatch>(d));
+}
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,515 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::math, operations on poses, quaternions and vectors, using SSE4.1 or NEON where available.
+ *
+ * @see xr::math
+ * @ingroup utilities
+ */
+
+#include "openxr_structs.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * @defgroup math Math
+ * @brief Operations on xr::Posef, xr::Quaternionf and xr::Vector3f.
+ *
+ * The implementation is chosen at compile time: SSE4.1 if the compiler targets it (e.g. `-msse4.1`, `-mavx2`,
+ * or `/arch:AVX` and up with MSVC), NEON on ARM, and plain C++ otherwise, or if `OPENXR_HPP_MATH_SCALAR` is defined.
+ * The plain C++ versions are always available in xr::math::scalar, as a reference.
+ *
+ * All of these work on the types as they are, with the same layout as their C counterparts.
+ *
+ * @ingroup utilities
+ */
+
+#if !defined(OPENXR_HPP_MATH_SCALAR)
+#if defined(__SSE4_1__) || defined(__AVX__) || defined(__AVX2__)
+#define OPENXR_HPP_MATH_SSE4 1
+#include <smmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define OPENXR_HPP_MATH_NEON 1
+#include <arm_neon.h>
+#endif
+#endif  // !OPENXR_HPP_MATH_SCALAR
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace math {
+    // The SIMD versions load and store these directly.
+    static_assert(offsetof(XrQuaternionf, w) == 3 * sizeof(float), "Quaternionf is four contiguous floats");
+    static_assert(offsetof(XrPosef, position) == sizeof(XrQuaternionf), "Posef is its orientation, then its position");
+
+    //! Plain C++ implementations, used when no SIMD instruction set is available.
+    namespace scalar {
+        OPENXR_HPP_INLINE float dot(Quaternionf const& a, Quaternionf const& b) noexcept {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        OPENXR_HPP_INLINE Quaternionf normalize(Quaternionf const& q) noexcept {
+            const float scale = 1.f / std::sqrt(dot(q, q));
+            return {q.x * scale, q.y * scale, q.z * scale, q.w * scale};
+        }
+
+        OPENXR_HPP_INLINE Quaternionf multiply(Quaternionf const& a, Quaternionf const& b) noexcept {
+            return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                    a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                    a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                    a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+        }
+
+        OPENXR_HPP_INLINE Vector3f rotate(Quaternionf const& q, Vector3f const& v) noexcept {
+            // v + w t + u x t, where u is the vector part of q and t = 2 u x v
+            const float tx = 2.f * (q.y * v.z - q.z * v.y);
+            const float ty = 2.f * (q.z * v.x - q.x * v.z);
+            const float tz = 2.f * (q.x * v.y - q.y * v.x);
+            return {v.x + q.w * tx + (q.y * tz - q.z * ty),
+                    v.y + q.w * ty + (q.z * tx - q.x * tz),
+                    v.z + q.w * tz + (q.x * ty - q.y * tx)};
+        }
+
+        OPENXR_HPP_INLINE Posef compose(Posef const& a, Posef const& b) noexcept {
+            const Vector3f offset = rotate(a.orientation, b.position);
+            return {multiply(a.orientation, b.orientation),
+                    {a.position.x + offset.x, a.position.y + offset.y, a.position.z + offset.z}};
+        }
+
+        OPENXR_HPP_INLINE Posef invert(Posef const& p) noexcept {
+            const Quaternionf inverse{-p.orientation.x, -p.orientation.y, -p.orientation.z, p.orientation.w};
+            const Vector3f position = rotate(inverse, p.position);
+            return {inverse, {-position.x, -position.y, -position.z}};
+        }
+
+        OPENXR_HPP_INLINE Vector3f transformPoint(Posef const& p, Vector3f const& v) noexcept {
+            const Vector3f rotated = rotate(p.orientation, v);
+            return {rotated.x + p.position.x, rotated.y + p.position.y, rotated.z + p.position.z};
+        }
+
+        OPENXR_HPP_INLINE Quaternionf slerp(Quaternionf const& a, Quaternionf const& b, float t) noexcept {
+            float cosine = dot(a, b);
+            // Take the shorter way around.
+            const float sign = cosine < 0.f ? -1.f : 1.f;
+            cosine *= sign;
+            float weightA = 1.f - t;
+            float weightB = t * sign;
+            if (cosine < 0.9995f) {
+                const float angle = std::acos(cosine);
+                const float inverseSine = 1.f / std::sin(angle);
+                weightA = std::sin(weightA * angle) * inverseSine;
+                weightB = std::sin(t * angle) * inverseSine * sign;
+            }
+            return normalize({weightA * a.x + weightB * b.x, weightA * a.y + weightB * b.y,
+                              weightA * a.z + weightB * b.z, weightA * a.w + weightB * b.w});
+        }
+    }  // namespace scalar
+
+#if defined(OPENXR_HPP_MATH_SSE4)
+    //! SSE4.1 implementations.
+    namespace simd {
+        using Register = __m128;
+
+        template <int Lane>
+        OPENXR_HPP_INLINE Register broadcast(Register r) noexcept {
+            return _mm_shuffle_ps(r, r, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+        }
+
+        OPENXR_HPP_INLINE Register load(Quaternionf const& q) noexcept { return _mm_loadu_ps(&q.x); }
+        OPENXR_HPP_INLINE Register load(Vector3f const& v) noexcept { return _mm_setr_ps(v.x, v.y, v.z, 0.f); }
+
+        OPENXR_HPP_INLINE Quaternionf storeQuaternion(Register r) noexcept {
+            Quaternionf q{Uninitialized{}};
+            _mm_storeu_ps(&q.x, r);
+            return q;
+        }
+
+        OPENXR_HPP_INLINE Vector3f storeVector(Register r) noexcept {
+            return {_mm_cvtss_f32(r), _mm_cvtss_f32(broadcast<1>(r)), _mm_cvtss_f32(_mm_movehl_ps(r, r))};
+        }
+
+        //! (x, y, z, w) to (y, z, x, w)
+        OPENXR_HPP_INLINE Register yzx(Register r) noexcept { return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1)); }
+
+        OPENXR_HPP_INLINE Register dot4(Register a, Register b) noexcept { return _mm_dp_ps(a, b, 0xff); }
+
+        OPENXR_HPP_INLINE Register multiply(Register a, Register b) noexcept {
+            const Register wzyx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+            const Register zwxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+            const Register yxwz = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+            Register r = _mm_mul_ps(broadcast<3>(a), b);
+            r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(broadcast<0>(a), wzyx), _mm_setr_ps(0.f, -0.f, 0.f, -0.f)));
+            r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(broadcast<1>(a), zwxy), _mm_setr_ps(0.f, 0.f, -0.f, -0.f)));
+            return _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(broadcast<2>(a), yxwz), _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)));
+        }
+
+        //! a x b in the first three lanes
+        OPENXR_HPP_INLINE Register cross(Register a, Register b) noexcept {
+            return yzx(_mm_sub_ps(_mm_mul_ps(a, yzx(b)), _mm_mul_ps(yzx(a), b)));
+        }
+
+        OPENXR_HPP_INLINE Register rotate(Register q, Register v) noexcept {
+            const Register t = cross(q, v);
+            const Register t2 = _mm_add_ps(t, t);
+            return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(broadcast<3>(q), t2)), cross(q, t2));
+        }
+
+        OPENXR_HPP_INLINE Register conjugate(Register q) noexcept {
+            return _mm_xor_ps(q, _mm_setr_ps(-0.f, -0.f, -0.f, 0.f));
+        }
+
+        OPENXR_HPP_INLINE Register loadFloats(const float* p) noexcept { return _mm_loadu_ps(p); }
+        OPENXR_HPP_INLINE void storeFloats(float* p, Register r) noexcept { _mm_storeu_ps(p, r); }
+        OPENXR_HPP_INLINE Register splat(float f) noexcept { return _mm_set1_ps(f); }
+
+        OPENXR_HPP_INLINE Register add(Register a, Register b) noexcept { return _mm_add_ps(a, b); }
+
+        OPENXR_HPP_INLINE Register mul(Register a, Register b) noexcept { return _mm_mul_ps(a, b); }
+
+        OPENXR_HPP_INLINE Register negate(Register v) noexcept { return _mm_xor_ps(v, _mm_set1_ps(-0.f)); }
+
+        OPENXR_HPP_INLINE Register normalize(Register q) noexcept { return _mm_div_ps(q, _mm_sqrt_ps(dot4(q, q))); }
+
+        OPENXR_HPP_INLINE Register blend(Register a, float weightA, Register b, float weightB) noexcept {
+            return _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(weightA)), _mm_mul_ps(b, _mm_set1_ps(weightB)));
+        }
+
+        OPENXR_HPP_INLINE float first(Register r) noexcept { return _mm_cvtss_f32(r); }
+    }  // namespace simd
+#elif defined(OPENXR_HPP_MATH_NEON)
+    //! NEON implementations.
+    namespace simd {
+        using Register = float32x4_t;
+
+        OPENXR_HPP_INLINE Register set(float x, float y, float z, float w) noexcept {
+            const float lanes[4] = {x, y, z, w};
+            return vld1q_f32(lanes);
+        }
+
+        OPENXR_HPP_INLINE Register load(Quaternionf const& q) noexcept { return vld1q_f32(&q.x); }
+        OPENXR_HPP_INLINE Register load(Vector3f const& v) noexcept { return set(v.x, v.y, v.z, 0.f); }
+
+        OPENXR_HPP_INLINE Quaternionf storeQuaternion(Register r) noexcept {
+            Quaternionf q{Uninitialized{}};
+            vst1q_f32(&q.x, r);
+            return q;
+        }
+
+        OPENXR_HPP_INLINE Vector3f storeVector(Register r) noexcept {
+            return {vgetq_lane_f32(r, 0), vgetq_lane_f32(r, 1), vgetq_lane_f32(r, 2)};
+        }
+
+        template <int Lane>
+        OPENXR_HPP_INLINE Register broadcast(Register r) noexcept {
+            return vdupq_n_f32(vgetq_lane_f32(r, Lane));
+        }
+
+        //! (x, y, z, w) to (y, z, x, x): the last lane is unused.
+        OPENXR_HPP_INLINE Register yzx(Register r) noexcept {
+            return vsetq_lane_f32(vgetq_lane_f32(r, 0), vextq_f32(r, r, 1), 2);
+        }
+
+        OPENXR_HPP_INLINE Register dot4(Register a, Register b) noexcept {
+            const Register products = vmulq_f32(a, b);
+#if defined(__aarch64__) || defined(_M_ARM64)
+            return vdupq_n_f32(vaddvq_f32(products));
+#else
+            const float32x2_t halves = vadd_f32(vget_low_f32(products), vget_high_f32(products));
+            return vdupq_lane_f32(vpadd_f32(halves, halves), 0);
+#endif
+        }
+
+        OPENXR_HPP_INLINE Register multiply(Register a, Register b) noexcept {
+            const Register zwxy = vextq_f32(b, b, 2);
+            const Register wzyx = vrev64q_f32(zwxy);
+            const Register yxwz = vrev64q_f32(b);
+            Register r = vmulq_f32(broadcast<3>(a), b);
+            r = vmlaq_f32(r, vmulq_f32(broadcast<0>(a), wzyx), set(1.f, -1.f, 1.f, -1.f));
+            r = vmlaq_f32(r, vmulq_f32(broadcast<1>(a), zwxy), set(1.f, 1.f, -1.f, -1.f));
+            return vmlaq_f32(r, vmulq_f32(broadcast<2>(a), yxwz), set(-1.f, 1.f, 1.f, -1.f));
+        }
+
+        //! a x b in the first three lanes
+        OPENXR_HPP_INLINE Register cross(Register a, Register b) noexcept {
+            return yzx(vsubq_f32(vmulq_f32(a, yzx(b)), vmulq_f32(yzx(a), b)));
+        }
+
+        OPENXR_HPP_INLINE Register rotate(Register q, Register v) noexcept {
+            const Register t = cross(q, v);
+            const Register t2 = vaddq_f32(t, t);
+            return vaddq_f32(vmlaq_f32(v, broadcast<3>(q), t2), cross(q, t2));
+        }
+
+        OPENXR_HPP_INLINE Register conjugate(Register q) noexcept { return vmulq_f32(q, set(-1.f, -1.f, -1.f, 1.f)); }
+
+        OPENXR_HPP_INLINE Register loadFloats(const float* p) noexcept { return vld1q_f32(p); }
+        OPENXR_HPP_INLINE void storeFloats(float* p, Register r) noexcept { vst1q_f32(p, r); }
+        OPENXR_HPP_INLINE Register splat(float f) noexcept { return vdupq_n_f32(f); }
+
+        OPENXR_HPP_INLINE Register add(Register a, Register b) noexcept { return vaddq_f32(a, b); }
+
+        OPENXR_HPP_INLINE Register mul(Register a, Register b) noexcept { return vmulq_f32(a, b); }
+
+        OPENXR_HPP_INLINE Register negate(Register v) noexcept { return vnegq_f32(v); }
+
+        OPENXR_HPP_INLINE Register normalize(Register q) noexcept {
+            return vmulq_n_f32(q, 1.f / std::sqrt(vgetq_lane_f32(dot4(q, q), 0)));
+        }
+
+        OPENXR_HPP_INLINE Register blend(Register a, float weightA, Register b, float weightB) noexcept {
+            return vmlaq_n_f32(vmulq_n_f32(a, weightA), b, weightB);
+        }
+
+        OPENXR_HPP_INLINE float first(Register r) noexcept { return vgetq_lane_f32(r, 0); }
+    }  // namespace simd
+#endif
+
+#if defined(OPENXR_HPP_MATH_SSE4) || defined(OPENXR_HPP_MATH_NEON)
+    namespace simd {
+        // The same operations as xr::math::scalar, on top of the register functions above.
+
+        OPENXR_HPP_INLINE float dot(Quaternionf const& a, Quaternionf const& b) noexcept {
+            return first(dot4(load(a), load(b)));
+        }
+
+        OPENXR_HPP_INLINE Quaternionf normalize(Quaternionf const& q) noexcept {
+            return storeQuaternion(normalize(load(q)));
+        }
+
+        OPENXR_HPP_INLINE Quaternionf multiply(Quaternionf const& a, Quaternionf const& b) noexcept {
+            return storeQuaternion(multiply(load(a), load(b)));
+        }
+
+        OPENXR_HPP_INLINE Vector3f rotate(Quaternionf const& q, Vector3f const& v) noexcept {
+            return storeVector(rotate(load(q), load(v)));
+        }
+
+        OPENXR_HPP_INLINE Posef compose(Posef const& a, Posef const& b) noexcept {
+            const Register orientation = load(a.orientation);
+            return {storeQuaternion(multiply(orientation, load(b.orientation))),
+                    storeVector(add(load(a.position), rotate(orientation, load(b.position))))};
+        }
+
+        OPENXR_HPP_INLINE Posef invert(Posef const& p) noexcept {
+            const Register inverse = conjugate(load(p.orientation));
+            return {storeQuaternion(inverse), storeVector(negate(rotate(inverse, load(p.position))))};
+        }
+
+        OPENXR_HPP_INLINE Vector3f transformPoint(Posef const& p, Vector3f const& v) noexcept {
+            return storeVector(add(rotate(load(p.orientation), load(v)), load(p.position)));
+        }
+
+        OPENXR_HPP_INLINE Quaternionf slerp(Quaternionf const& a, Quaternionf const& b, float t) noexcept {
+            const Register ra = load(a);
+            const Register rb = load(b);
+            float cosine = first(dot4(ra, rb));
+            const float sign = cosine < 0.f ? -1.f : 1.f;
+            cosine *= sign;
+            float weightA = 1.f - t;
+            float weightB = t * sign;
+            if (cosine < 0.9995f) {
+                const float angle = std::acos(cosine);
+                const float inverseSine = 1.f / std::sin(angle);
+                weightA = std::sin(weightA * angle) * inverseSine;
+                weightB = std::sin(t * angle) * inverseSine * sign;
+            }
+            return storeQuaternion(normalize(blend(ra, weightA, rb, weightB)));
+        }
+    }  // namespace simd
+
+    namespace selected = simd;
+#else
+    namespace selected = scalar;
+#endif
+
+    namespace impl {
+        // Kernels over structure-of-arrays data are written once, as templates over one of these.
+
+        //! Lane operations on one float at a time.
+        struct ScalarLanes {
+            using Register = float;
+            using Mask = uint32_t;
+            static constexpr size_t width = 1;
+
+            static Register load(const float* p) noexcept { return *p; }
+            static void store(float* p, Register r) noexcept { *p = r; }
+            static Mask loadMask(const uint32_t* p) noexcept { return *p; }
+            static void storeMask(uint32_t* p, Mask m) noexcept { *p = m; }
+            static Register set1(float f) noexcept { return f; }
+            static Register add(Register a, Register b) noexcept { return a + b; }
+            static Register sub(Register a, Register b) noexcept { return a - b; }
+            static Register mul(Register a, Register b) noexcept { return a * b; }
+            static Register div(Register a, Register b) noexcept { return a / b; }
+            static Register min(Register a, Register b) noexcept { return b < a ? b : a; }
+            static Register max(Register a, Register b) noexcept { return a < b ? b : a; }
+            static Register sqrt(Register a) noexcept { return std::sqrt(a); }
+            static Mask both(Mask a, Mask b) noexcept { return a & b; }
+            //! @p a where @p m is set, @p b elsewhere.
+            static Register select(Mask m, Register a, Register b) noexcept { return m ? a : b; }
+        };
+
+#if defined(OPENXR_HPP_MATH_SSE4)
+        //! Lane operations on four floats at a time, with SSE4.1.
+        struct SimdLanes {
+            using Register = __m128;
+            using Mask = __m128;
+            static constexpr size_t width = 4;
+
+            static Register load(const float* p) noexcept { return _mm_load_ps(p); }
+            static void store(float* p, Register r) noexcept { _mm_store_ps(p, r); }
+            static Mask loadMask(const uint32_t* p) noexcept {
+                return _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+            }
+            static void storeMask(uint32_t* p, Mask m) noexcept {
+                _mm_store_si128(reinterpret_cast<__m128i*>(p), _mm_castps_si128(m));
+            }
+            static Register set1(float f) noexcept { return _mm_set1_ps(f); }
+            static Register add(Register a, Register b) noexcept { return _mm_add_ps(a, b); }
+            static Register sub(Register a, Register b) noexcept { return _mm_sub_ps(a, b); }
+            static Register mul(Register a, Register b) noexcept { return _mm_mul_ps(a, b); }
+            static Register div(Register a, Register b) noexcept { return _mm_div_ps(a, b); }
+            static Register min(Register a, Register b) noexcept { return _mm_min_ps(a, b); }
+            static Register max(Register a, Register b) noexcept { return _mm_max_ps(a, b); }
+            static Register sqrt(Register a) noexcept { return _mm_sqrt_ps(a); }
+            static Mask both(Mask a, Mask b) noexcept { return _mm_and_ps(a, b); }
+            static Register select(Mask m, Register a, Register b) noexcept { return _mm_blendv_ps(b, a, m); }
+        };
+#elif defined(OPENXR_HPP_MATH_NEON)
+        //! Lane operations on four floats at a time, with NEON.
+        struct SimdLanes {
+            using Register = float32x4_t;
+            using Mask = uint32x4_t;
+            static constexpr size_t width = 4;
+
+            static Register load(const float* p) noexcept { return vld1q_f32(p); }
+            static void store(float* p, Register r) noexcept { vst1q_f32(p, r); }
+            static Mask loadMask(const uint32_t* p) noexcept { return vld1q_u32(p); }
+            static void storeMask(uint32_t* p, Mask m) noexcept { vst1q_u32(p, m); }
+            static Register set1(float f) noexcept { return vdupq_n_f32(f); }
+            static Register add(Register a, Register b) noexcept { return vaddq_f32(a, b); }
+            static Register sub(Register a, Register b) noexcept { return vsubq_f32(a, b); }
+            static Register mul(Register a, Register b) noexcept { return vmulq_f32(a, b); }
+            static Register div(Register a, Register b) noexcept {
+#if defined(__aarch64__) || defined(_M_ARM64)
+                return vdivq_f32(a, b);
+#else
+                // Refine the reciprocal estimate twice, for full precision.
+                Register reciprocal = vrecpeq_f32(b);
+                reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+                reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+                return vmulq_f32(a, reciprocal);
+#endif
+            }
+            static Register min(Register a, Register b) noexcept { return vminq_f32(a, b); }
+            static Register max(Register a, Register b) noexcept { return vmaxq_f32(a, b); }
+            static Register sqrt(Register a) noexcept {
+#if defined(__aarch64__) || defined(_M_ARM64)
+                return vsqrtq_f32(a);
+#else
+                float lanes[4];
+                vst1q_f32(lanes, a);
+                return simd::set(std::sqrt(lanes[0]), std::sqrt(lanes[1]), std::sqrt(lanes[2]), std::sqrt(lanes[3]));
+#endif
+            }
+            static Mask both(Mask a, Mask b) noexcept { return vandq_u32(a, b); }
+            static Register select(Mask m, Register a, Register b) noexcept { return vbslq_f32(m, a, b); }
+        };
+#endif
+
+#if defined(OPENXR_HPP_MATH_SSE4) || defined(OPENXR_HPP_MATH_NEON)
+        using SelectedLanes = SimdLanes;
+#else
+        using SelectedLanes = ScalarLanes;
+#endif
+    }  // namespace impl
+
+    /*!
+     * @addtogroup math
+     * @{
+     */
+
+    //! The four-component dot product of two quaternions.
+    OPENXR_HPP_INLINE float dot(Quaternionf const& a, Quaternionf const& b) noexcept { return selected::dot(a, b); }
+
+    //! Scale a quaternion to unit length.
+    OPENXR_HPP_INLINE Quaternionf normalize(Quaternionf const& q) noexcept { return selected::normalize(q); }
+
+    //! The Hamilton product: the rotation @p b followed by @p a.
+    OPENXR_HPP_INLINE Quaternionf multiply(Quaternionf const& a, Quaternionf const& b) noexcept {
+        return selected::multiply(a, b);
+    }
+
+    // Vectors only fill three lanes, and the compiler does better vectorizing the plain C++ across a loop of them,
+    // so rotate and transform* always use xr::math::scalar. compose and invert use the SIMD rotate internally.
+
+    //! Rotate a vector by a unit quaternion.
+    OPENXR_HPP_INLINE Vector3f rotate(Quaternionf const& q, Vector3f const& v) noexcept { return scalar::rotate(q, v); }
+
+    /*!
+     * @brief Compose two poses.
+     *
+     * If @p b is a pose in the space of @p a, and @p a is a pose in space S, the result is @p b in space S.
+     */
+    OPENXR_HPP_INLINE Posef compose(Posef const& a, Posef const& b) noexcept { return selected::compose(a, b); }
+
+    //! The inverse of a rigid pose: compose(p, invert(p)) is the identity.
+    OPENXR_HPP_INLINE Posef invert(Posef const& p) noexcept { return selected::invert(p); }
+
+    //! Transform a point: rotate, then translate.
+    OPENXR_HPP_INLINE Vector3f transformPoint(Posef const& p, Vector3f const& v) noexcept {
+        return scalar::transformPoint(p, v);
+    }
+
+    //! Transform a direction: rotate only.
+    OPENXR_HPP_INLINE Vector3f transformVector(Posef const& p, Vector3f const& v) noexcept {
+        return scalar::rotate(p.orientation, v);
+    }
+
+    /*!
+     * @brief Spherical linear interpolation between two unit quaternions, along the shorter arc.
+     *
+     * Falls back to normalized linear interpolation when they are nearly equal.
+     */
+    OPENXR_HPP_INLINE Quaternionf slerp(Quaternionf const& a, Quaternionf const& b, float t) noexcept {
+        return selected::slerp(a, b, t);
+    }
+
+    //! @}
+}  // namespace math
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,290 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::math::Matrix4x4f and functions building projection, view and view-projection matrices and
+ * culling frusta from xr::View.
+ *
+ * @see xr::math::computeViewMatrices
+ * @ingroup utilities
+ */
+
+#include "openxr_math.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace math {
+    /*!
+     * @addtogroup math
+     * @{
+     */
+
+    //! A 4x4 matrix, column-major, as OpenGL, Vulkan and the OpenXR samples' xr_linear.h expect.
+    struct Matrix4x4f {
+        alignas(16) float m[16];
+    };
+
+    //! The clip-space conventions of the graphics APIs.
+    enum class ClipSpace {
+        //! Depth from -1 to 1, Y up.
+        OpenGL,
+        //! Depth from 0 to 1, Y up.
+        Direct3D,
+        //! Depth from 0 to 1, Y down.
+        Vulkan,
+    };
+
+    //! Which way depth goes.
+    enum class DepthDirection {
+        //! The near plane maps to the smallest depth.
+        Standard,
+        //! The near plane maps to the largest depth, for better precision with floating-point depth buffers.
+        Reversed,
+    };
+
+    //! The tangents of the angles of a field of view, from which projections are built.
+    struct FovTangents {
+        float left;
+        float right;
+        float up;
+        float down;
+    };
+
+    //! The tangents of the angles of @p fov.
+    OPENXR_HPP_INLINE FovTangents tangents(Fovf const& fov) noexcept {
+        return {std::tan(fov.angleLeft), std::tan(fov.angleRight), std::tan(fov.angleUp), std::tan(fov.angleDown)};
+    }
+
+    /*!
+     * @brief A projection matrix for a view with the field of view given by @p tan.
+     *
+     * A @p farZ that is not beyond @p nearZ gives an infinite far plane.
+     */
+    OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE Matrix4x4f
+    projection(FovTangents const& tan, float nearZ, float farZ, ClipSpace clip = ClipSpace::OpenGL,
+               DepthDirection depth = DepthDirection::Standard) noexcept {
+        const float width = tan.right - tan.left;
+        const float height = clip == ClipSpace::Vulkan ? tan.down - tan.up : tan.up - tan.down;
+        const bool zeroToOne = clip != ClipSpace::OpenGL;
+        // Depth of a point at view-space z is (m10 * z + m14) / -z.
+        const float offsetZ = zeroToOne ? 0.f : nearZ;
+        float m10 = -1.f;
+        float m14 = -(nearZ + offsetZ);
+        if (farZ > nearZ) {
+            m10 = -(farZ + offsetZ) / (farZ - nearZ);
+            m14 = -(farZ * (nearZ + offsetZ)) / (farZ - nearZ);
+        }
+        if (depth == DepthDirection::Reversed) {
+            // Depth becomes 1 - depth from 0 to 1, or -depth from -1 to 1.
+            m10 = (zeroToOne ? -1.f : 0.f) - m10;
+            m14 = -m14;
+        }
+        return {{2.f / width, 0.f, 0.f, 0.f,
+                 0.f, 2.f / height, 0.f, 0.f,
+                 (tan.right + tan.left) / width, (tan.up + tan.down) / height, m10, -1.f,
+                 0.f, 0.f, m14, 0.f}};
+    }
+
+    //! A projection matrix for a view with field of view @p fov.
+    OPENXR_HPP_INLINE Matrix4x4f projection(Fovf const& fov, float nearZ, float farZ,
+                                            ClipSpace clip = ClipSpace::OpenGL,
+                                            DepthDirection depth = DepthDirection::Standard) noexcept {
+        return projection(tangents(fov), nearZ, farZ, clip, depth);
+    }
+
+    //! The matrix transforming points by @p pose, rotating then translating.
+    OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE Matrix4x4f matrix(Posef const& pose) noexcept {
+        const Quaternionf& q = pose.orientation;
+        const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+        const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+        return {{1.f - yy - zz, xy + wz, xz - wy, 0.f,
+                 xy - wz, 1.f - xx - zz, yz + wx, 0.f,
+                 xz + wy, yz - wx, 1.f - xx - yy, 0.f,
+                 pose.position.x, pose.position.y, pose.position.z, 1.f}};
+    }
+
+    //! The view matrix of a view at @p pose: the inverse of matrix(pose).
+    OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE Matrix4x4f viewMatrix(Posef const& pose) noexcept {
+        Matrix4x4f result = matrix(pose);
+        // Transpose the rotation, and rotate the negated translation by it.
+        const float px = result.m[12], py = result.m[13], pz = result.m[14];
+        float swap = result.m[1];
+        result.m[1] = result.m[4];
+        result.m[4] = swap;
+        swap = result.m[2];
+        result.m[2] = result.m[8];
+        result.m[8] = swap;
+        swap = result.m[6];
+        result.m[6] = result.m[9];
+        result.m[9] = swap;
+        result.m[12] = -(result.m[0] * px + result.m[4] * py + result.m[8] * pz);
+        result.m[13] = -(result.m[1] * px + result.m[5] * py + result.m[9] * pz);
+        result.m[14] = -(result.m[2] * px + result.m[6] * py + result.m[10] * pz);
+        return result;
+    }
+
+    namespace scalar {
+        //! The product @p a times @p b: the transformation @p b followed by @p a.
+        OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE Matrix4x4f multiply(Matrix4x4f const& a,
+                                                                    Matrix4x4f const& b) noexcept {
+            Matrix4x4f result{};
+            for (int column = 0; column < 4; ++column) {
+                for (int row = 0; row < 4; ++row) {
+                    float sum = 0.f;
+                    for (int k = 0; k < 4; ++k) {
+                        sum += a.m[k * 4 + row] * b.m[column * 4 + k];
+                    }
+                    result.m[column * 4 + row] = sum;
+                }
+            }
+            return result;
+        }
+    }  // namespace scalar
+
+    //! The product @p a times @p b: the transformation @p b followed by @p a.
+    OPENXR_HPP_INLINE Matrix4x4f multiply(Matrix4x4f const& a, Matrix4x4f const& b) noexcept {
+#if defined(OPENXR_HPP_MATH_SSE4) || defined(OPENXR_HPP_MATH_NEON)
+        const simd::Register a0 = simd::loadFloats(a.m);
+        const simd::Register a1 = simd::loadFloats(a.m + 4);
+        const simd::Register a2 = simd::loadFloats(a.m + 8);
+        const simd::Register a3 = simd::loadFloats(a.m + 12);
+        Matrix4x4f result;
+        for (int column = 0; column < 4; ++column) {
+            const float* factors = &b.m[column * 4];
+            const simd::Register sum =
+                simd::add(simd::add(simd::mul(a0, simd::splat(factors[0])), simd::mul(a1, simd::splat(factors[1]))),
+                          simd::add(simd::mul(a2, simd::splat(factors[2])), simd::mul(a3, simd::splat(factors[3]))));
+            simd::storeFloats(result.m + column * 4, sum);
+        }
+        return result;
+#else
+        return scalar::multiply(a, b);
+#endif
+    }
+
+    //! A plane: points p with dot(normal, p) + distance >= 0 are on the inside.
+    struct Plane {
+        Vector3f normal;
+        float distance;
+    };
+
+    //! The planes bounding what a view can see: left, right, bottom, top, near and far.
+    struct Frustum {
+        Plane planes[6];
+
+        //! Whether any of a sphere might be visible.
+        bool intersectsSphere(Vector3f const& center, float radius) const noexcept {
+            for (Plane const& plane : planes) {
+                const float d = plane.normal.x * center.x + plane.normal.y * center.y + plane.normal.z * center.z;
+                if (d + plane.distance < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /*!
+     * @brief The frustum of a view at @p pose with the field of view given by @p tan, in the space of @p pose.
+     *
+     * It does not depend on the clip-space convention. A @p farZ that is not beyond @p nearZ gives a far plane
+     * everything is inside.
+     */
+    OPENXR_HPP_INLINE Frustum frustum(Posef const& pose, FovTangents const& tan, float nearZ, float farZ) noexcept {
+        // In view space, looking down -Z.
+        const Plane local[6] = {
+            {{1.f, 0.f, tan.left}, 0.f},
+            {{-1.f, 0.f, -tan.right}, 0.f},
+            {{0.f, 1.f, tan.down}, 0.f},
+            {{0.f, -1.f, -tan.up}, 0.f},
+            {{0.f, 0.f, -1.f}, -nearZ},
+            {{0.f, 0.f, 1.f}, farZ > nearZ ? farZ : std::numeric_limits<float>::infinity()},
+        };
+        Frustum result;
+        for (int i = 0; i < 6; ++i) {
+            const Vector3f n = local[i].normal;
+            const float scale = 1.f / std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            const Vector3f normal = scalar::rotate(pose.orientation, {n.x * scale, n.y * scale, n.z * scale});
+            result.planes[i].normal = normal;
+            result.planes[i].distance =
+                local[i].distance * scale -
+                (normal.x * pose.position.x + normal.y * pose.position.y + normal.z * pose.position.z);
+        }
+        return result;
+    }
+
+    //! Everything needed to render and cull one view.
+    struct ViewMatrices {
+        Matrix4x4f projection;
+        Matrix4x4f view;
+        //! projection times view.
+        Matrix4x4f viewProjection;
+        //! In the space the views were located in.
+        Frustum frustum;
+    };
+
+    /*!
+     * @brief Compute the matrices and frustum of each of @p views, as returned by Session::locateViews.
+     *
+     * @return The number of views computed: the smaller of the sizes of @p views and @p out.
+     */
+    OPENXR_HPP_INLINE size_t computeViewMatrices(Span<const View> views, float nearZ, float farZ,
+                                                Span<ViewMatrices> out, ClipSpace clip = ClipSpace::OpenGL,
+                                                DepthDirection depth = DepthDirection::Standard) noexcept {
+        const size_t count = views.size() < out.size() ? views.size() : out.size();
+        for (size_t i = 0; i < count; ++i) {
+            const FovTangents tan = tangents(views[i].fov);
+            ViewMatrices& matrices = out[i];
+            matrices.projection = projection(tan, nearZ, farZ, clip, depth);
+            matrices.view = viewMatrix(views[i].pose);
+            matrices.viewProjection = multiply(matrices.projection, matrices.view);
+            matrices.frustum = frustum(views[i].pose, tan, nearZ, farZ);
+        }
+        return count;
+    }
+
+    //! @}
+}  // namespace math
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
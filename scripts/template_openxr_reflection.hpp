@@ -0,0 +1,175 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::StructDescriptor and xr::forEachField, compile-time descriptions of the fields of each struct,
+ * for writing generic serializers, formatters and the like.
+ *
+ * @see xr::FieldDescriptor, xr::StructDescriptor, xr::forEachField
+ * @ingroup structs
+ */
+
+#include "openxr_structs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Description of one field of a struct, as laid out in the original OpenXR type.
+ *
+ * @ingroup structs
+ */
+struct FieldDescriptor {
+    //! Name of the member
+    const char* name;
+    //! C type of the member, or of its elements if it is a pointer or an array, e.g. `XrCompositionLayerBaseHeader`
+    const char* type;
+    //! Name of the sibling member holding the element count of a pointer member, or nullptr if there is none
+    const char* countField;
+    //! Offset of the member in the struct
+    size_t offset;
+    //! Size of the member, in bytes: for pointers, the size of the pointer
+    size_t size;
+    //! Number of elements of a fixed-size array member, or 1
+    size_t arrayLength;
+    //! Number of levels of indirection: e.g. 2 for `const XrCompositionLayerBaseHeader* const* layers`
+    uint32_t pointerDepth;
+    //! Whether the member points to something
+    bool isPointer;
+};
+
+/*!
+ * @brief Compile-time description of the fields of a projected struct @p T, all members included.
+ *
+ * Specialized for each projected struct and for its original OpenXR type, with these members:
+ *
+ * - `raw_type`: the original OpenXR type
+ * - `name`: the name of the original OpenXR type
+ * - `field_count`: the number of members
+ * - `fields`: a constexpr array of FieldDescriptor, in declaration order
+ * - `forEachField(s, visitor)`: see xr::forEachField
+ *
+ * The unused second parameter lets the static data members be defined in a header.
+ *
+ * @ingroup structs
+ */
+template <typename T, typename Unused = void>
+struct StructDescriptor;
+
+namespace impl {
+    //! Number of elements of a (possibly multidimensional) array type, or 1.
+    template <typename T>
+    struct element_count : std::integral_constant<size_t, 1> {};
+    template <typename T, size_t N>
+    struct element_count<T[N]> : std::integral_constant<size_t, N * element_count<T>::value> {};
+
+    //! The original OpenXR type of a projected struct or a reference to one, keeping constness.
+    template <typename Raw, typename T>
+    using raw_like_t = typename std::conditional<std::is_const<T>::value, Raw const, Raw>::type;
+
+    template <typename Raw, typename T>
+    OPENXR_HPP_INLINE raw_like_t<Raw, T>& asRaw(T& s) noexcept {
+        static_assert(sizeof(T) == sizeof(Raw), "only for projections of Raw");
+        return reinterpret_cast<raw_like_t<Raw, T>&>(s);
+    }
+}  // namespace impl
+
+#ifndef OPENXR_HPP_DOXYGEN
+//# for struct in gen.api_structures if struct.name not in manually_projected and struct.name not in gen.skip_projection and not struct.alias
+//#     set s = project_struct(struct)
+/*{ protect_begin(struct) }*/
+template <typename Unused>
+struct StructDescriptor</*{ s.cpp_name }*/, Unused> {
+    using raw_type = /*{ struct.name }*/;
+    static constexpr const char* name = "/*{ struct.name }*/";
+    static constexpr size_t field_count = /*{ struct.members | count }*/;
+    static constexpr FieldDescriptor fields[field_count] = {
+//#     for member in struct.members
+//#         set count_field = member_count_field(struct, member)
+        {"/*{ member.name }*/", "/*{ member.type }*/", /*{ '"' + count_field + '"' if count_field else "nullptr" }*/, offsetof(raw_type, /*{ member.name }*/),
+         sizeof(raw_type::/*{ member.name }*/), impl::element_count<decltype(raw_type::/*{ member.name }*/)>::value, /*{ member.pointer_count }*/, /*{ "true" if member.pointer_count else "false" }*/},
+//#     endfor
+    };
+
+    template <typename S, typename Visitor>
+    static OPENXR_HPP_INLINE void forEachField(S& s, Visitor&& visitor) {
+        auto& raw = impl::asRaw<raw_type>(s);
+//#     for member in struct.members
+        visitor(fields[/*{ loop.index0 }*/], raw./*{ member.name }*/);
+//#     endfor
+    }
+};
+template <typename Unused>
+constexpr const char* StructDescriptor</*{ s.cpp_name }*/, Unused>::name;
+template <typename Unused>
+constexpr size_t StructDescriptor</*{ s.cpp_name }*/, Unused>::field_count;
+template <typename Unused>
+constexpr FieldDescriptor StructDescriptor</*{ s.cpp_name }*/, Unused>::fields[];
+template <typename Unused>
+struct StructDescriptor</*{ struct.name }*/, Unused> : StructDescriptor</*{ s.cpp_name }*/, Unused> {};
+/*{ protect_end(struct) }*/
+
+//# endfor
+#endif  // !OPENXR_HPP_DOXYGEN
+
+/*!
+ * @brief Calls @p visitor with the FieldDescriptor and a reference to the value of each member of @p s, in order.
+ *
+ * @p s may be a projected struct or an original OpenXR struct, and const or not: the members are passed as references
+ * to their original OpenXR types, with the constness of @p s. Everything is known at compile time, so once inlined
+ * this costs no more than accessing the members by name.
+ *
+ * ```{.cpp}
+ * size_t offset = 0;
+ * xr::forEachField(frameEndInfo, [&](xr::FieldDescriptor const& field, auto const& value) {
+ *     if (!field.isPointer) {
+ *         memcpy(buffer + offset, &value, sizeof(value));
+ *         offset += sizeof(value);
+ *     }
+ * });
+ * ```
+ *
+ * @ingroup structs
+ */
+template <typename T, typename Visitor>
+OPENXR_HPP_INLINE void forEachField(T& s, Visitor&& visitor) {
+    StructDescriptor<typename std::remove_const<T>::type>::forEachField(s, visitor);
+}
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,267 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::SpaceLocationCache, for sharing the results of xrLocateSpace between the subsystems and threads
+ * that need them within a frame.
+ *
+ * @see xr::SpaceLocationCache
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_structs.hpp"
+#include "openxr_structure_chain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Caches the results of xrLocateSpace by space, base space and time, so that subsystems locating the same
+ * spaces in the same frame call the runtime only once.
+ *
+ * Call locateSpace() in place of Space::locateSpace(): if a SpaceVelocity is chained to the SpaceLocation, the
+ * velocity is located and cached too. Other structs in the chain are neither filled in nor passed to the runtime.
+ * Only successful results are cached.
+ *
+ * Call beginFrame() once per frame, e.g. after xrWaitFrame, to drop the previous frame's results. Results are also
+ * dropped when the cache is passed an xr::EventDataReferenceSpaceChangePending, as an event visitor:
+ *
+ * ```{.cpp}
+ * xr::SpaceLocationCache<> cache;
+ * // On the frame thread:
+ * eventPump.drain(cache);
+ * cache.beginFrame();
+ * // On the render and physics threads:
+ * xr::SpaceLocation location;
+ * cache.locateSpace(handSpace, stageSpace, frameState.predictedDisplayTime, location);
+ * ```
+ *
+ * Entries are split into @p Shards shards, each with its own lock and @p SlotsPerShard entries, chosen by space and
+ * base space, so threads locating different spaces rarely contend. The lock is not held while calling the runtime.
+ * Dropping results is lock-free, by advancing a generation count that entries are tagged with.
+ *
+ * @ingroup utilities
+ */
+template <size_t Shards = 8, size_t SlotsPerShard = 16>
+class SpaceLocationCache {
+   public:
+    SpaceLocationCache() noexcept = default;
+    SpaceLocationCache(SpaceLocationCache const&) = delete;
+    SpaceLocationCache& operator=(SpaceLocationCache const&) = delete;
+
+    /*!
+     * @brief Locate @p space in @p baseSpace at @p time, from the cache if possible, else with xrLocateSpace.
+     *
+     * Fills in `locationFlags` and `pose` of @p location, and of a SpaceVelocity chained to it, if any.
+     * May be called from any thread.
+     *
+     * @return The result of xrLocateSpace, or Result::Success when served from the cache.
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    Result locateSpace(Space space, Space baseSpace, Time time, SpaceLocation& location,
+                       Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) {
+        SpaceVelocity* velocity = findInChain<SpaceVelocity>(location.next);
+        Shard& shard = m_shards[shardIndex(space, baseSpace)];
+        // Read before locating, so an entry from before an invalidation can never be tagged as after it.
+        const uint64_t generation = m_generation.load(std::memory_order_acquire);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Entry* entry = shard.find(space, baseSpace, time, generation);
+            if (entry != nullptr && (entry->hasVelocity || velocity == nullptr)) {
+                entry->copyTo(location, velocity);
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return Result::Success;
+            }
+        }
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+        Entry located;
+        SpaceVelocity locatedVelocity;
+        SpaceLocation locatedLocation;
+        if (velocity != nullptr) {
+            locatedLocation.next = &locatedVelocity;
+        }
+        const Result result = static_cast<Result>(
+            d.xrLocateSpace(space.get(), baseSpace.get(), time.get(), locatedLocation.put()));
+        if (!succeeded(result)) {
+            return result;
+        }
+        located.generation = generation;
+        located.space = space;
+        located.baseSpace = baseSpace;
+        located.time = time;
+        located.hasVelocity = velocity != nullptr;
+        located.locationFlags = locatedLocation.locationFlags;
+        located.pose = locatedLocation.pose;
+        located.velocityFlags = locatedVelocity.velocityFlags;
+        located.linearVelocity = locatedVelocity.linearVelocity;
+        located.angularVelocity = locatedVelocity.angularVelocity;
+        located.copyTo(location, velocity);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            // Not if invalidated while locating: the result may predate the invalidation.
+            if (m_generation.load(std::memory_order_acquire) == generation) {
+                shard.insert(located);
+            }
+        }
+        return result;
+    }
+
+    //! Drop every cached result. May be called from any thread.
+    void invalidate() noexcept { m_generation.fetch_add(1, std::memory_order_acq_rel); }
+
+    //! Drop the previous frame's results: call once per frame.
+    void beginFrame() noexcept { invalidate(); }
+
+    //! Event visitor: a reference space is about to change, so drop every cached result.
+    void operator()(EventDataReferenceSpaceChangePending const&) noexcept { invalidate(); }
+
+    //! The number of calls to locateSpace() served from the cache.
+    uint64_t hits() const noexcept { return sum(&Shard::hits); }
+
+    //! The number of calls to locateSpace() that called xrLocateSpace.
+    uint64_t misses() const noexcept { return sum(&Shard::misses); }
+
+    //! The fraction of calls to locateSpace() served from the cache, or 0 if there were none.
+    double hitRate() const noexcept {
+        const uint64_t hitCount = hits();
+        const uint64_t total = hitCount + misses();
+        return total == 0 ? 0. : static_cast<double>(hitCount) / static_cast<double>(total);
+    }
+
+    //! Reset hits() and misses() to zero.
+    void resetStatistics() noexcept {
+        for (Shard& shard : m_shards) {
+            shard.hits.store(0, std::memory_order_relaxed);
+            shard.misses.store(0, std::memory_order_relaxed);
+        }
+    }
+
+   private:
+    struct Entry {
+        //! Zero for an entry never written, which no generation matches.
+        uint64_t generation = 0;
+        Space space;
+        Space baseSpace;
+        Time time;
+        bool hasVelocity = false;
+        SpaceLocationFlags locationFlags;
+        Posef pose;
+        SpaceVelocityFlags velocityFlags;
+        Vector3f linearVelocity;
+        Vector3f angularVelocity;
+
+        bool matches(Space s, Space base, Time t) const noexcept {
+            return space == s && baseSpace == base && time == t;
+        }
+
+        void copyTo(SpaceLocation& location, SpaceVelocity* velocity) const noexcept {
+            location.locationFlags = locationFlags;
+            location.pose = pose;
+            if (velocity != nullptr) {
+                velocity->velocityFlags = velocityFlags;
+                velocity->linearVelocity = linearVelocity;
+                velocity->angularVelocity = angularVelocity;
+            }
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        Entry entries[SlotsPerShard];
+        //! Where to insert next when no entry is stale.
+        size_t victim = 0;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        //! Keeps the next shard's lock off this shard's last cache line.
+        char padding[64];
+
+        Entry* find(Space space, Space baseSpace, Time time, uint64_t generation) noexcept {
+            for (Entry& entry : entries) {
+                if (entry.generation == generation && entry.matches(space, baseSpace, time)) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        //! Replace an entry for the same key, else a stale entry, else the next victim.
+        void insert(Entry const& located) noexcept {
+            Entry* stale = nullptr;
+            for (Entry& entry : entries) {
+                if (entry.generation != located.generation) {
+                    if (stale == nullptr) {
+                        stale = &entry;
+                    }
+                } else if (entry.matches(located.space, located.baseSpace, located.time)) {
+                    entry = located;
+                    return;
+                }
+            }
+            if (stale == nullptr) {
+                stale = &entries[victim];
+                victim = (victim + 1) % SlotsPerShard;
+            }
+            *stale = located;
+        }
+    };
+
+    static size_t shardIndex(Space space, Space baseSpace) noexcept {
+        size_t seed = 0;
+        impl::hashCombine(seed, std::hash<Space>{}(space));
+        impl::hashCombine(seed, std::hash<Space>{}(baseSpace));
+        return seed % Shards;
+    }
+
+    uint64_t sum(std::atomic<uint64_t> Shard::*counter) const noexcept {
+        uint64_t total = 0;
+        for (Shard const& shard : m_shards) {
+            total += (shard.*counter).load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    Shard m_shards[Shards];
+    std::atomic<uint64_t> m_generation{1};
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
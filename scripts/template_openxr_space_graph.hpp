@@ -0,0 +1,247 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::SpaceGraph, for locating many spaces relative to each other with one xrLocateSpace call per
+ * space.
+ *
+ * @see xr::SpaceGraph, xr::relativeLocationFlags
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_joints.hpp"
+#include "openxr_math.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief The flags of a space located relative to another, given the flags each was located with relative to a
+ * common base space.
+ *
+ * Orientation is valid or tracked only if both are. Position is valid or tracked only if both positions are, and so
+ * is the orientation of @p relativeTo, which the position is rotated into.
+ *
+ * @ingroup utilities
+ */
+OPENXR_HPP_INLINE SpaceLocationFlags relativeLocationFlags(SpaceLocationFlags space,
+                                                           SpaceLocationFlags relativeTo) noexcept {
+    SpaceLocationFlags flags = space & relativeTo;
+    if (!(relativeTo & SpaceLocationFlagBits::OrientationValid)) {
+        flags &= ~SpaceLocationFlags{SpaceLocationFlagBits::PositionValid};
+    }
+    if (!(relativeTo & SpaceLocationFlagBits::OrientationTracked)) {
+        flags &= ~SpaceLocationFlags{SpaceLocationFlagBits::PositionTracked};
+    }
+    return flags;
+}
+
+/*!
+ * @brief Up to @p MaxSpaces spaces, each located once per frame against a common base space, so that any of them can
+ * be located relative to any other without calling xrLocateSpace again.
+ *
+ * Locating N spaces against each other directly takes N² calls to xrLocateSpace. Instead, add() each space once, call
+ * update() once per frame to locate each against the base space, then call locate() or locateAll() as often as
+ * needed: they compose the poses located by update(), using SSE4.1 or NEON like the rest of xr::math.
+ *
+ * Flags are carried through the composition by relativeLocationFlags(), so a pose is only as valid, and as tracked,
+ * as both poses it was computed from. The result matches what the runtime would report for the same display time
+ * up to rounding, provided the base space is one the runtime locates everything against consistently, such as a
+ * stage or local reference space.
+ *
+ * ```{.cpp}
+ * xr::SpaceGraph<> graph{stageSpace};
+ * const size_t controller = graph.add(controllerSpace);
+ * const size_t anchor = graph.add(anchorSpace);
+ * // Once per frame:
+ * graph.update(frameState.predictedDisplayTime);
+ * xr::SpaceLocation anchorInController = graph.locate(anchor, controller);
+ * ```
+ *
+ * The spaces are not owned.
+ *
+ * @ingroup utilities
+ */
+template <size_t MaxSpaces = 64>
+class SpaceGraph {
+   public:
+    //! Returned by add() when the graph is full, and by find() for spaces not in the graph.
+    static constexpr size_t noIndex = static_cast<size_t>(-1);
+
+    //! Constructor: spaces will be located relative to @p base.
+    explicit SpaceGraph(Space base) noexcept : m_base(base) { clear(); }
+
+    //! Forget every space, keeping the base space.
+    void clear() noexcept {
+        m_poses.count = 0;
+        for (size_t i = 0; i < math::JointBatch<MaxSpaces>::paddedCapacity; ++i) {
+            setPose(i, Posef{});
+            m_poses.valid[i] = 0u;
+        }
+        for (size_t i = 0; i < MaxSpaces; ++i) {
+            m_spaces[i] = Space{};
+            m_flags[i] = SpaceLocationFlags{};
+        }
+    }
+
+    /*!
+     * @brief Add @p space to the graph, unlocated until the next update().
+     *
+     * @return The index to pass to locate(), the existing index if @p space was already added, or noIndex if the
+     * graph is full.
+     */
+    size_t add(Space space) noexcept {
+        const size_t existing = find(space);
+        if (existing != noIndex) {
+            return existing;
+        }
+        if (m_poses.count == MaxSpaces) {
+            return noIndex;
+        }
+        m_spaces[m_poses.count] = space;
+        return m_poses.count++;
+    }
+
+    //! The index of @p space, or noIndex if it has not been added.
+    size_t find(Space space) const noexcept {
+        for (size_t i = 0; i < m_poses.count; ++i) {
+            if (m_spaces[i] == space) {
+                return i;
+            }
+        }
+        return noIndex;
+    }
+
+    /*!
+     * @brief Locate every space against the base space at @p time: one call to xrLocateSpace per space.
+     *
+     * A space that fails to locate keeps going, with no location flags set, until the next update().
+     *
+     * @return Result::Success, or the first failure.
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+    Result update(Time time, Dispatch&& d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG) noexcept {
+        Result result = Result::Success;
+        for (size_t i = 0; i < m_poses.count; ++i) {
+            SpaceLocation location;
+            const Result located =
+                static_cast<Result>(d.xrLocateSpace(m_spaces[i].get(), m_base.get(), time.get(), location.put()));
+            if (!succeeded(located)) {
+                if (succeeded(result)) {
+                    result = located;
+                }
+                location = SpaceLocation{};
+            }
+            setPose(i, location.pose);
+            m_poses.valid[i] = 0xffffffffu;
+            m_flags[i] = location.locationFlags;
+        }
+        return result;
+    }
+
+    /*!
+     * @brief Space @p space located relative to space @p relativeTo, both indices from add(), as of the last
+     * update().
+     */
+    SpaceLocation locate(size_t space, size_t relativeTo) const noexcept {
+        SpaceLocation location;
+        location.locationFlags = relativeLocationFlags(m_flags[space], m_flags[relativeTo]);
+        location.pose = math::compose(math::invert(m_poses.pose(relativeTo)), m_poses.pose(space));
+        return location;
+    }
+
+    /*!
+     * @brief Every space located relative to space @p relativeTo, in @p locations, by index.
+     *
+     * Only `locationFlags` and `pose` are written, so a `next` chain is left alone.
+     *
+     * @return The number of locations written: the smaller of size() and the size of @p locations.
+     */
+    size_t locateAll(size_t relativeTo, Span<SpaceLocation> locations) const noexcept {
+        math::JointBatch<MaxSpaces> poses = m_poses;
+        math::transformJoints(math::invert(m_poses.pose(relativeTo)), poses);
+        const size_t count = locations.size() < m_poses.count ? locations.size() : m_poses.count;
+        for (size_t i = 0; i < count; ++i) {
+            locations[i].locationFlags = relativeLocationFlags(m_flags[i], m_flags[relativeTo]);
+            locations[i].pose = poses.pose(i);
+        }
+        return count;
+    }
+
+    //! The space every other is located against.
+    Space base() const noexcept { return m_base; }
+
+    //! The number of spaces added.
+    size_t size() const noexcept { return m_poses.count; }
+
+    //! Space @p index.
+    Space space(size_t index) const noexcept { return m_spaces[index]; }
+
+    //! Space @p index located against the base space, as of the last update().
+    SpaceLocation location(size_t index) const noexcept {
+        SpaceLocation location;
+        location.locationFlags = m_flags[index];
+        location.pose = m_poses.pose(index);
+        return location;
+    }
+
+   private:
+    void setPose(size_t i, Posef const& pose) noexcept {
+        m_poses.positionX[i] = pose.position.x;
+        m_poses.positionY[i] = pose.position.y;
+        m_poses.positionZ[i] = pose.position.z;
+        m_poses.orientationX[i] = pose.orientation.x;
+        m_poses.orientationY[i] = pose.orientation.y;
+        m_poses.orientationZ[i] = pose.orientation.z;
+        m_poses.orientationW[i] = pose.orientation.w;
+    }
+
+    Space m_base;
+    Space m_spaces[MaxSpaces];
+    SpaceLocationFlags m_flags[MaxSpaces];
+    //! Poses against the base space, in structure-of-arrays form, with every located space valid.
+    math::JointBatch<MaxSpaces> m_poses;
+};
+
+template <size_t MaxSpaces>
+constexpr size_t SpaceGraph<MaxSpaces>::noIndex;
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,146 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+
+/**
+ * @file
+ * @brief Contains xr::Span, a non-owning view of contiguous elements.
+ *
+ * @see xr::Span
+ * @ingroup utilities
+ */
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+//# include('defines.hpp') without context
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief A non-owning view of @p T elements stored contiguously, like `std::span` from C++20.
+ *
+ * Used for the pointer and count member pairs of structs, and for input array parameters:
+ * the view refers to the elements in place, nothing is copied.
+ * Constructible from a pointer and a count, a C array, or any container with `data()` and `size()`,
+ * such as `std::vector` and `std::array`. A span of const elements can also view a braced list, when passing
+ * one to a function as in `f({a, b})`: as with `std::span` in C++26, such a span must not be used past the end
+ * of the full-expression it appears in. So must a span of a temporary container. The setters of structs, which keep
+ * the pointer, reject both.
+ *
+ * @ingroup utilities
+ */
+template <typename T>
+class Span {
+    template <typename U>
+    using enable_if_compatible = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type;
+
+    template <typename Container>
+    using container_element_t = typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type;
+
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    //! Empty span.
+    OPENXR_HPP_CONSTEXPR Span() noexcept = default;
+
+    //! View of @p count elements starting at @p data.
+    OPENXR_HPP_CONSTEXPR Span(T* data, size_t count) noexcept : m_data(data), m_size(count) {}
+
+    //! View of a C array.
+    template <size_t N>
+    OPENXR_HPP_CONSTEXPR Span(T (&arr)[N]) noexcept : m_data(arr), m_size(N) {}
+
+    //! View of the elements of a contiguous container: it must outlive the span.
+    template <typename Container, typename = enable_if_compatible<container_element_t<Container>>>
+    OPENXR_HPP_CONSTEXPR Span(Container& container) noexcept(noexcept(container.data()))
+        : m_data(container.data()), m_size(container.size()) {}
+
+    /*!
+     * @brief View of the elements of a const or temporary contiguous container, for spans of const elements, as with
+     * `std::span<const T>`: a temporary is only valid until the end of the full-expression.
+     */
+    template <typename Container,
+              typename U = T,
+              typename = typename std::enable_if<std::is_const<U>::value>::type,
+              typename = enable_if_compatible<container_element_t<Container const>>>
+    OPENXR_HPP_CONSTEXPR Span(Container const& container) noexcept(noexcept(container.data()))
+        : m_data(container.data()), m_size(container.size()) {}
+
+    //! View of a braced list, for spans of const elements: only valid until the end of the full-expression.
+    template <typename U = T, typename = typename std::enable_if<std::is_const<U>::value>::type>
+    OPENXR_HPP_CONSTEXPR Span(std::initializer_list<value_type> list) noexcept : Span(list.begin(), list.size()) {}
+
+    //! Conversion, e.g. from a span of non-const elements to a span of const ones.
+    template <typename U, typename = enable_if_compatible<U>>
+    OPENXR_HPP_CONSTEXPR Span(Span<U> const& other) noexcept : m_data(other.data()), m_size(other.size()) {}
+
+    //! Pointer to the first element.
+    OPENXR_HPP_CONSTEXPR T* data() const noexcept { return m_data; }
+
+    //! Number of elements.
+    OPENXR_HPP_CONSTEXPR size_t size() const noexcept { return m_size; }
+
+    //! True if there are no elements.
+    OPENXR_HPP_CONSTEXPR bool empty() const noexcept { return m_size == 0; }
+
+    //! Element @p i, which must be less than size().
+    OPENXR_HPP_CONSTEXPR T& operator[](size_t i) const noexcept { return m_data[i]; }
+
+    OPENXR_HPP_CONSTEXPR T* begin() const noexcept { return m_data; }
+
+    OPENXR_HPP_CONSTEXPR T* end() const noexcept { return m_data + m_size; }
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+namespace impl {
+    //! True if a forwarding reference deduced @p T for a temporary, other than a span: what struct setters reject.
+    template <typename T>
+    struct is_temporary_container : std::integral_constant<bool, !std::is_reference<T>::value> {};
+    template <typename T>
+    struct is_temporary_container<Span<T>> : std::false_type {};
+}  // namespace impl
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -57,12 +57,6 @@
  * @ingroup typedstructs
  */
 
-// for strncpy_s
-#ifndef __STDC_WANT_LIB_EXT1__
-#define __STDC_WANT_LIB_EXT1__ 1
-#endif
-#include <string.h>
-
 #include "openxr_enums.hpp"
 #include "openxr_flags.hpp"
 #include "openxr_version.hpp"
@@ -70,21 +64,52 @@
 #include "openxr_atoms.hpp"
 #include "openxr_bool.hpp"
 #include "openxr_handles.hpp"
+#include "openxr_span.hpp"
 
 #include <openxr/openxr.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
 #ifdef OPENXR_HPP_DOXYGEN
 #include <openxr/openxr_platform.h>
 #endif
 
 namespace OPENXR_HPP_NAMESPACE {
 
+/*!
+ * @brief Tag type selecting the structure constructors that leave all members except `type` and `next` uninitialized.
+ *
+ * Useful for output structures that the runtime fills in completely, e.g. large property structs,
+ * where clearing them first would just be overwritten.
+ * Only pass such a structure to calls that fully populate it, and use `put(false)` to avoid clearing it anyway.
+ *
+ * @ingroup structs
+ */
+struct Uninitialized {};
+
+namespace traits {
+    //! Type trait associating a StructureType enum value with its C++ type.
+    template <StructureType s>
+    struct cpp_type_from_structure_type;
+
+    //! Type trait associating a typed C++ structure type with its StructureType enum value, as `value`.
+    //! For any other type, `value` is StructureType::Unknown.
+    template <typename T>
+    struct structure_type_of : std::integral_constant<StructureType, StructureType::Unknown> {};
+}  // namespace traits
+
 namespace impl {
 
     class XR_MAY_ALIAS InputStructBase {
     protected:
-        InputStructBase(StructureType type_,
-                        const void* next_ = nullptr)
+        OPENXR_HPP_CONSTEXPR InputStructBase(StructureType type_,
+                                             const void* next_ = nullptr)
             : type(type_), next(next_) {}
 
     public:
@@ -95,7 +120,7 @@ namespace impl {
 
     class XR_MAY_ALIAS OutputStructBase {
     protected:
-        OutputStructBase(StructureType type_, void* next_ = nullptr)
+        OPENXR_HPP_CONSTEXPR OutputStructBase(StructureType type_, void* next_ = nullptr)
             : type(type_), next(next_) {}
 
     public:
@@ -103,6 +128,115 @@ namespace impl {
         void* next;
     };
     /*{ wrapperSizeStaticAssert('::XrBaseOutStructure', 'OutputStructBase') }*/
+
+    //! @brief Copies a string into a fixed-size, zero-initialized member array, truncating it to fit with its null terminator.
+    //!
+    //! Unlike strncpy, usable in constant expressions as of C++14, for constructors of structs with such members.
+    template <size_t N>
+    OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE void copyStaticLengthString(char (&dst)[N], const char* src) noexcept {
+        for (size_t i = 0; src != nullptr && i + 1 < N && src[i] != '\0'; ++i) {
+            dst[i] = src[i];
+        }
+    }
+
+    //! Copies @p N elements into a fixed-size member array: usable in constant expressions as of C++14.
+    template <typename T, size_t N>
+    OPENXR_HPP_CONSTEXPR14 OPENXR_HPP_INLINE void copyStaticLengthArray(T (&dst)[N], const T* src) noexcept {
+        for (size_t i = 0; src != nullptr && i < N; ++i) {
+            dst[i] = src[i];
+        }
+    }
+
+    //! Mixes the hash of one more member into @p seed.
+    OPENXR_HPP_INLINE void hashCombine(size_t& seed, size_t value) noexcept {
+        seed ^= value + static_cast<size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2);
+    }
+
+    //! Hashes an enum member through its underlying type, as std::hash of enums is only required as of C++14.
+    template <typename T>
+    OPENXR_HPP_INLINE typename std::enable_if<std::is_enum<T>::value, size_t>::type hashValue(T const& v) noexcept {
+        using Underlying = typename std::underlying_type<T>::type;
+        return std::hash<Underlying>{}(static_cast<Underlying>(v));
+    }
+
+    //! Hashes a member with std::hash.
+    template <typename T>
+    OPENXR_HPP_INLINE typename std::enable_if<!std::is_enum<T>::value, size_t>::type hashValue(T const& v) noexcept {
+        return std::hash<T>{}(v);
+    }
+
+    //! Hashes a fixed-size array member element by element.
+    template <typename T, size_t N>
+    OPENXR_HPP_INLINE size_t hashValue(T const (&arr)[N]) noexcept {
+        size_t seed = 0;
+        for (T const& element : arr) {
+            hashCombine(seed, hashValue(element));
+        }
+        return seed;
+    }
+
+    //! Hashes a fixed-size string member, up to its null terminator.
+    template <size_t N>
+    OPENXR_HPP_INLINE size_t hashValue(char const (&str)[N]) noexcept {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < N && str[i] != '\0'; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(str[i])) * 0x100000001b3ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    //! Hashes the bytes of a member of a platform type.
+    template <typename T>
+    OPENXR_HPP_INLINE size_t hashBytes(T const& v) noexcept {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ull;
+        auto bytes = reinterpret_cast<unsigned char const*>(&v);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    //! Compares a member with operator==.
+    template <typename T>
+    OPENXR_HPP_INLINE bool equalValue(T const& lhs, T const& rhs) noexcept {
+        return lhs == rhs;
+    }
+
+    //! Compares fixed-size array members element by element.
+    template <typename T, size_t N>
+    OPENXR_HPP_INLINE bool equalValue(T const (&lhs)[N], T const (&rhs)[N]) noexcept {
+        for (size_t i = 0; i < N; ++i) {
+            if (!equalValue(lhs[i], rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Compares fixed-size string members up to their null terminator.
+    template <size_t N>
+    OPENXR_HPP_INLINE bool equalValue(char const (&lhs)[N], char const (&rhs)[N]) noexcept {
+        return strncmp(lhs, rhs, N) == 0;
+    }
+
+    //! Compares the bytes of members of a platform type.
+    template <typename T>
+    OPENXR_HPP_INLINE bool equalBytes(T const& lhs, T const& rhs) noexcept {
+        return memcmp(&lhs, &rhs, sizeof(T)) == 0;
+    }
+
+    //! Calls the visitor with the structure if it has an overload accepting it.
+    template <typename Visitor, typename T>
+    OPENXR_HPP_INLINE auto visitIfAccepted(Visitor&& visitor, T const& t, int)
+        -> decltype(static_cast<void>(std::forward<Visitor>(visitor)(t))) {
+        std::forward<Visitor>(visitor)(t);
+    }
+
+    //! Fallback: the visitor does not accept this structure type, so it is ignored.
+    template <typename Visitor, typename T>
+    OPENXR_HPP_INLINE void visitIfAccepted(Visitor&&, T const&, ...) {}
 }  // namespace impl
 
 //# filter block_doxygen_comment
@@ -126,6 +260,8 @@ public:
     EventDataBuffer() : Parent(StructureType::EventDataBuffer), varying{} {
         (void)varying;
     }
+    //! @brief Constructor leaving the event payload uninitialized: use for a buffer reused across calls with `put(false)`.
+    explicit EventDataBuffer(Uninitialized) noexcept : Parent(StructureType::EventDataBuffer) {}
     //! @brief "Put" function for assigning as null then getting the address of the raw pointer to pass as function output parameter.
     XrEventDataBuffer* put(bool clear = true) noexcept {
         if (clear) {
@@ -166,6 +302,130 @@ OPENXR_HPP_INLINE XrEventDataBuffer* put(EventDataBuffer& v, bool clear = true)
 
 //# endfor
 
+//# for struct in gen.api_structures if struct.name not in manually_projected and struct.name not in gen.skip_projection
+//#     set s = project_struct(struct)
+//#     if not s.is_abstract
+//#         set visible_members = struct.members | reject('cpp_hidden_member') | list
+/*{ protect_begin(struct) }*/
+//# filter block_doxygen_comment
+//! @brief Member-wise equality of /*{ s.cpp_name }*/, ignoring `next`: pointer members are compared by address.
+//! @relates /*{ s.cpp_name }*/
+//# endfilter
+OPENXR_HPP_INLINE bool operator==(/*{ s.cpp_name }*/ const&/*% if visible_members %*/ lhs/*% endif %*/, /*{ s.cpp_name }*/ const&/*% if visible_members %*/ rhs/*% endif %*/) noexcept {
+//#         if visible_members
+    return
+//#             for member in visible_members
+//#                 if compares_by_bytes(member)
+        /*{ "&& " if not loop.first }*/impl::equalBytes(lhs./*{ member.name }*/, rhs./*{ member.name }*/)/*{ ";" if loop.last }*/
+//#                 else
+        /*{ "&& " if not loop.first }*/impl::equalValue(lhs./*{ member.name }*/, rhs./*{ member.name }*/)/*{ ";" if loop.last }*/
+//#                 endif
+//#             endfor
+//#         else
+    return true;
+//#         endif
+}
+//! @brief Member-wise inequality of /*{ s.cpp_name }*/, ignoring `next`.
+//! @relates /*{ s.cpp_name }*/
+OPENXR_HPP_INLINE bool operator!=(/*{ s.cpp_name }*/ const& lhs, /*{ s.cpp_name }*/ const& rhs) noexcept {
+    return !(lhs == rhs);
+}
+/*{ protect_end(struct) }*/
+//#     endif
+//# endfor
+
+//# for parent_name in gen.parents | sort if parent_name in gen.dict_structs and parent_name not in gen.skip_projection
+//#     set parent = gen.dict_structs[parent_name]
+//#     set p = project_struct(parent)
+/*{ protect_begin(parent) }*/
+//# filter block_doxygen_comment
+//! @brief Calls the overload of @p visitor for the projected type of @p base, e.g. a /*{ p.cpp_name }*/-derived struct.
+//!
+//! The struct is passed as a reference to const of its projected type, selected with a single switch on `type`.
+//! Types the visitor has no overload for are ignored: add an overload taking /*{ p.cpp_name }*/
+//! to catch those, as well as types unknown to this version of OpenXR-Hpp.
+//!
+//! @return true if the type was known, false if it was passed as /*{ p.cpp_name }*/ because it was not.
+//!
+//! @relates /*{ p.cpp_name }*/
+//! @ingroup utilities
+//# endfilter
+template <typename Visitor>
+OPENXR_HPP_INLINE bool visit(/*{ p.cpp_name }*/ const& base, Visitor&& visitor) {
+    switch (base.type) {
+//#     for name in struct_children[parent_name] | sort if name in gen.dict_structs and name not in gen.skip_projection
+//#         set child = gen.dict_structs[name]
+//#         set s = project_struct(child)
+//#         if s.struct_type_enum
+        /*{ protect_begin(child, parent) }*/
+        case /*{ s.struct_type_enum }*/:
+            impl::visitIfAccepted(std::forward<Visitor>(visitor), *reinterpret_cast</*{ s.cpp_name }*/ const*>(&base), 0);
+            return true;
+        /*{ protect_end(child, parent) }*/
+//#         endif
+//#     endfor
+        default:
+            impl::visitIfAccepted(std::forward<Visitor>(visitor), base, 0);
+            return false;
+    }
+}
+/*{ protect_end(parent) }*/
+
+//# endfor
+
+#ifndef OPENXR_HPP_DOXYGEN
+namespace traits {
+// Explicit specializations of cpp_type_from_structure_type and structure_type_of
+template <>
+struct cpp_type_from_structure_type<StructureType::EventDataBuffer> {
+    using type = EventDataBuffer;
+};
+template <>
+struct structure_type_of<EventDataBuffer> : std::integral_constant<StructureType, StructureType::EventDataBuffer> {};
+//# for struct in gen.api_structures if struct.name not in manually_projected and struct.name not in gen.skip_projection and not struct.alias
+//#     set s = project_struct(struct)
+//#     if s.struct_type_enum
+/*{ protect_begin(struct) }*/
+template <>
+struct cpp_type_from_structure_type</*{ s.struct_type_enum }*/> {
+    using type = /*{ s.cpp_name }*/;
+};
+template <>
+struct structure_type_of</*{ s.cpp_name }*/> : std::integral_constant<StructureType, /*{ s.struct_type_enum }*/> {};
+/*{ protect_end(struct) }*/
+//#     endif
+//# endfor
+}  // namespace traits
+#endif  // !OPENXR_HPP_DOXYGEN
+
 }  // namespace OPENXR_HPP_NAMESPACE
 
+#ifndef OPENXR_HPP_DOXYGEN
+namespace std {
+// Hash specializations for the structs: member-wise, ignoring `next`, consistent with their operator==.
+//# for struct in gen.api_structures if struct.name not in manually_projected and struct.name not in gen.skip_projection
+//#     set s = project_struct(struct)
+//#     if not s.is_abstract
+//#         set visible_members = struct.members | reject('cpp_hidden_member') | list
+/*{ protect_begin(struct) }*/
+template <>
+struct hash<OPENXR_HPP_NAMESPACE::/*{ s.cpp_name }*/> {
+    size_t operator()(OPENXR_HPP_NAMESPACE::/*{ s.cpp_name }*/ const&/*% if visible_members %*/ s/*% endif %*/) const noexcept {
+        size_t seed = 0;
+//#         for member in visible_members
+//#             if compares_by_bytes(member)
+        OPENXR_HPP_NAMESPACE::impl::hashCombine(seed, OPENXR_HPP_NAMESPACE::impl::hashBytes(s./*{ member.name }*/));
+//#             else
+        OPENXR_HPP_NAMESPACE::impl::hashCombine(seed, OPENXR_HPP_NAMESPACE::impl::hashValue(s./*{ member.name }*/));
+//#             endif
+//#         endfor
+        return seed;
+    }
+};
+/*{ protect_end(struct) }*/
+//#     endif
+//# endfor
+}  // namespace std
+#endif  // !OPENXR_HPP_DOXYGEN
+
 //# include('file_footer.hpp')
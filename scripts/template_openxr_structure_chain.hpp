@@ -0,0 +1,415 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::StructureChain, for building `next` chains without heap allocation, the traits::struct_extends trait,
+ * and utilities for searching, iterating, hashing and comparing `next` chains.
+ *
+ * @see xr::StructureChain, xr::traits::struct_extends, xr::findInChain, xr::chainRange, xr::visitChain, xr::hashChain
+ * @ingroup structs
+ */
+
+#include "openxr_structs.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+namespace traits {
+    /*!
+     * @brief Type trait: whether the projected struct @p Ext may be chained to @p Base through `next`.
+     *
+     * Generated from the `structextends` attribute of the registry.
+     * Default implementation is "false".
+     *
+     * @ingroup structs
+     */
+    template <typename Ext, typename Base>
+    struct struct_extends : std::false_type {};
+}  // namespace traits
+
+#ifndef OPENXR_HPP_DOXYGEN
+namespace traits {
+// Explicit specializations of struct_extends
+//# for name, bases in struct_extends | dictsort if name in gen.dict_structs and name not in gen.skip_projection
+//#     set ext = gen.dict_structs[name]
+/*{ protect_begin(ext) }*/
+//#     for base_name in bases if base_name in gen.dict_structs and base_name not in gen.skip_projection
+//#         set base = gen.dict_structs[base_name]
+/*{ protect_begin(base, ext) }*/
+template <>
+struct struct_extends</*{ project_type_name(name) }*/, /*{ project_type_name(base_name) }*/> : std::true_type {};
+/*{ protect_end(base, ext) }*/
+//#     endfor
+/*{ protect_end(ext) }*/
+//# endfor
+}  // namespace traits
+#endif  // !OPENXR_HPP_DOXYGEN
+
+namespace impl {
+    template <bool...>
+    struct bool_pack;
+
+    //! True if all of the bools are true.
+    template <bool... Bs>
+    using all_true = std::is_same<bool_pack<true, Bs...>, bool_pack<Bs..., true>>;
+
+    //! Number of times T appears in Ts.
+    template <typename T, typename... Ts>
+    struct type_count : std::integral_constant<size_t, 0> {};
+
+    template <typename T, typename U, typename... Ts>
+    struct type_count<T, U, Ts...>
+        : std::integral_constant<size_t, (std::is_same<T, U>::value ? 1 : 0) + type_count<T, Ts...>::value> {};
+
+    //! Index of the first T in Ts: T must appear in Ts.
+    template <typename T, typename... Ts>
+    struct type_index;
+
+    template <typename T, typename... Ts>
+    struct type_index<T, T, Ts...> : std::integral_constant<size_t, 0> {};
+
+    template <typename T, typename U, typename... Ts>
+    struct type_index<T, U, Ts...> : std::integral_constant<size_t, 1 + type_index<T, Ts...>::value> {};
+}  // namespace impl
+
+/*!
+ * @brief A head struct and the structs extending it, stored together and linked through `next` at construction.
+ *
+ * All structs are members of this object, so a chain on the stack needs no heap allocation.
+ * Each of @p Extensions must be allowed to extend @p Head (per traits::struct_extends), which is checked at compile time.
+ * The `next` of each struct is pointed at the following one, and re-pointed on copy;
+ * the `next` of the last struct is left as given, so the chain may be continued.
+ *
+ * ```{.cpp}
+ * xr::StructureChain<xr::SystemProperties, xr::SystemHandTrackingPropertiesEXT> chain;
+ * // The enhanced getSystemProperties() returns a new struct: fill in the chain's head in place instead.
+ * xrGetSystemProperties(instance.get(), systemId.get(), chain.get<xr::SystemProperties>().put(false));
+ * bool handTracking = static_cast<bool>(chain.get<xr::SystemHandTrackingPropertiesEXT>().supportsHandTracking);
+ * ```
+ *
+ * @ingroup structs
+ */
+template <typename Head, typename... Extensions>
+class StructureChain {
+    static_assert(impl::all_true<traits::struct_extends<Extensions, Head>::value...>::value,
+                  "Every extension struct in a StructureChain must be allowed to extend the head struct");
+
+public:
+    //! Default-constructs all structs, then links them.
+    StructureChain() { link(); }
+
+    //! Copies the given structs, then links them.
+    explicit StructureChain(Head const& head, Extensions const&... extensions) : m_structs(head, extensions...) {
+        link();
+    }
+
+    //! Copy constructor: links the copies to each other, not to the original.
+    StructureChain(StructureChain const& rhs) : m_structs(rhs.m_structs) { link(); }
+
+    //! Copy assignment: links the copies to each other, not to the original.
+    StructureChain& operator=(StructureChain const& rhs) {
+        m_structs = rhs.m_structs;
+        link();
+        return *this;
+    }
+
+    //! Accesses the struct of type @p T in the chain.
+    template <typename T>
+    T& get() noexcept {
+        static_assert(impl::type_count<T, Head, Extensions...>::value == 1,
+                      "get<T>() requires T to appear exactly once in the StructureChain");
+        return std::get<impl::type_index<T, Head, Extensions...>::value>(m_structs);
+    }
+
+    //! Accesses the struct of type @p T in the chain.
+    template <typename T>
+    T const& get() const noexcept {
+        static_assert(impl::type_count<T, Head, Extensions...>::value == 1,
+                      "get<T>() requires T to appear exactly once in the StructureChain");
+        return std::get<impl::type_index<T, Head, Extensions...>::value>(m_structs);
+    }
+
+private:
+    void link() noexcept { link(std::integral_constant<size_t, 0>{}); }
+
+    template <size_t I>
+    void link(std::integral_constant<size_t, I>) noexcept {
+        std::get<I>(m_structs).next = &std::get<I + 1>(m_structs);
+        link(std::integral_constant<size_t, I + 1>{});
+    }
+
+    void link(std::integral_constant<size_t, sizeof...(Extensions)>) noexcept {}
+
+    std::tuple<Head, Extensions...> m_structs;
+};
+
+/*!
+ * @brief Finds the first struct of type @p T in a `next` chain of input structs.
+ *
+ * @return a pointer to it, or nullptr if there is none.
+ *
+ * @ingroup structs
+ */
+template <typename T>
+OPENXR_HPP_INLINE T const* findInChain(const void* next) noexcept {
+    static_assert(traits::structure_type_of<T>::value != StructureType::Unknown, "findInChain requires a typed struct");
+    for (auto s = static_cast<XrBaseInStructure const*>(next); s != nullptr; s = s->next) {
+        if (static_cast<StructureType>(s->type) == traits::structure_type_of<T>::value) {
+            return reinterpret_cast<T const*>(s);
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * @brief Finds the first struct of type @p T in a `next` chain of output structs.
+ *
+ * @return a pointer to it, or nullptr if there is none.
+ *
+ * @ingroup structs
+ */
+template <typename T>
+OPENXR_HPP_INLINE T* findInChain(void* next) noexcept {
+    static_assert(traits::structure_type_of<T>::value != StructureType::Unknown, "findInChain requires a typed struct");
+    for (auto s = static_cast<XrBaseOutStructure*>(next); s != nullptr; s = s->next) {
+        if (static_cast<StructureType>(s->type) == traits::structure_type_of<T>::value) {
+            return reinterpret_cast<T*>(s);
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * @brief A range over the structs of a `next` chain, as @p Base: `XrBaseInStructure const` or `XrBaseOutStructure`.
+ *
+ * Obtain one from chainRange().
+ *
+ * @ingroup structs
+ */
+template <typename Base>
+class ChainRange {
+public:
+    //! Forward iterator following `next`.
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Base;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Base*;
+        using reference = Base&;
+
+        explicit iterator(Base* node = nullptr) noexcept : m_node(node) {}
+
+        reference operator*() const noexcept { return *m_node; }
+        pointer operator->() const noexcept { return m_node; }
+
+        iterator& operator++() noexcept {
+            m_node = m_node->next;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        bool operator==(iterator const& rhs) const noexcept { return m_node == rhs.m_node; }
+        bool operator!=(iterator const& rhs) const noexcept { return m_node != rhs.m_node; }
+
+    private:
+        Base* m_node;
+    };
+
+    explicit ChainRange(Base* first) noexcept : m_first(first) {}
+
+    iterator begin() const noexcept { return iterator{m_first}; }
+    iterator end() const noexcept { return iterator{}; }
+
+private:
+    Base* m_first;
+};
+
+//! @brief Range over a `next` chain of input structs.
+//! @relates ChainRange
+OPENXR_HPP_INLINE ChainRange<XrBaseInStructure const> chainRange(const void* next) noexcept {
+    return ChainRange<XrBaseInStructure const>{static_cast<XrBaseInStructure const*>(next)};
+}
+
+//! @brief Range over a `next` chain of output structs.
+//! @relates ChainRange
+OPENXR_HPP_INLINE ChainRange<XrBaseOutStructure> chainRange(void* next) noexcept {
+    return ChainRange<XrBaseOutStructure>{static_cast<XrBaseOutStructure*>(next)};
+}
+
+namespace impl {
+    //! Calls the overload of the visitor for the type of @p base, with a single switch on its type.
+    template <typename Visitor>
+    OPENXR_HPP_INLINE void visitChained(XrBaseInStructure const& base, Visitor& visitor) {
+        switch (static_cast<StructureType>(base.type)) {
+//# for struct in gen.api_structures if struct.name not in manually_projected and struct.name not in gen.skip_projection and not struct.alias
+//#     set s = project_struct(struct)
+//#     if s.struct_type_enum
+            /*{ protect_begin(struct) }*/
+            case /*{ s.struct_type_enum }*/:
+                visitIfAccepted(visitor, *reinterpret_cast</*{ s.cpp_name }*/ const*>(&base), 0);
+                return;
+            /*{ protect_end(struct) }*/
+//#     endif
+//# endfor
+            default:
+                visitIfAccepted(visitor, base, 0);
+                return;
+        }
+    }
+}  // namespace impl
+
+/*!
+ * @brief Calls the overload of @p visitor matching the type of each struct in a `next` chain, in order.
+ *
+ * Each struct is passed as a reference to const of its projected type.
+ * Types the visitor has no overload for are skipped;
+ * types unknown to this version of OpenXR-Hpp are passed as `XrBaseInStructure const&` if the visitor accepts that.
+ *
+ * @ingroup structs
+ */
+template <typename Visitor>
+OPENXR_HPP_INLINE void visitChain(const void* next, Visitor&& visitor) {
+    for (XrBaseInStructure const& base : chainRange(next)) {
+        impl::visitChained(base, visitor);
+    }
+}
+
+namespace impl {
+    //! Visitor combining the hash of each struct of a chain: unknown types only contribute their type.
+    struct ChainHasher {
+        size_t seed;
+
+        void operator()(XrBaseInStructure const& s) noexcept { hashCombine(seed, hashValue(s.type)); }
+
+        template <typename T>
+        void operator()(T const& s) noexcept {
+            hashCombine(seed, hashValue(s.type));
+            hashCombine(seed, std::hash<T>{}(s));
+        }
+    };
+
+    //! Visitor comparing a struct of a chain to the one at the same position in another: unknown types must be the same struct.
+    struct ChainComparer {
+        XrBaseInStructure const* other;
+        bool equal;
+
+        void operator()(XrBaseInStructure const& s) noexcept { equal = &s == other; }
+
+        template <typename T>
+        void operator()(T const& s) noexcept {
+            equal = s == *reinterpret_cast<T const*>(other);
+        }
+    };
+}  // namespace impl
+
+/*!
+ * @brief Hashes the structs of a `next` chain, consistently with equalChains().
+ *
+ * The `std::hash` specializations of the structs ignore `next`: combine with this to key a container on a whole chain,
+ * as ChainedHash does.
+ *
+ * @ingroup structs
+ */
+OPENXR_HPP_INLINE size_t hashChain(const void* next) noexcept {
+    impl::ChainHasher hasher{0};
+    for (XrBaseInStructure const& base : chainRange(next)) {
+        impl::visitChained(base, hasher);
+    }
+    return hasher.seed;
+}
+
+/*!
+ * @brief Compares two `next` chains struct by struct, with the operator== of each type.
+ *
+ * Structs of a type unknown to this version of OpenXR-Hpp are only equal to themselves.
+ *
+ * @ingroup structs
+ */
+OPENXR_HPP_INLINE bool equalChains(const void* lhs, const void* rhs) noexcept {
+    auto l = static_cast<XrBaseInStructure const*>(lhs);
+    auto r = static_cast<XrBaseInStructure const*>(rhs);
+    for (; l != nullptr && r != nullptr; l = l->next, r = r->next) {
+        if (l->type != r->type) {
+            return false;
+        }
+        impl::ChainComparer comparer{r, false};
+        impl::visitChained(*l, comparer);
+        if (!comparer.equal) {
+            return false;
+        }
+    }
+    return l == r;
+}
+
+/*!
+ * @brief Hash function object for a typed struct including its `next` chain, for use with ChainedEqualTo.
+ *
+ * ```{.cpp}
+ * std::unordered_map<xr::SwapchainCreateInfo, xr::Swapchain, xr::ChainedHash<xr::SwapchainCreateInfo>,
+ *                    xr::ChainedEqualTo<xr::SwapchainCreateInfo>> swapchains;
+ * ```
+ *
+ * @ingroup structs
+ */
+template <typename T>
+struct ChainedHash {
+    size_t operator()(T const& s) const noexcept {
+        size_t seed = std::hash<T>{}(s);
+        impl::hashCombine(seed, hashChain(s.next));
+        return seed;
+    }
+};
+
+/*!
+ * @brief Equality function object for a typed struct including its `next` chain, for use with ChainedHash.
+ *
+ * @ingroup structs
+ */
+template <typename T>
+struct ChainedEqualTo {
+    bool operator()(T const& lhs, T const& rhs) const noexcept { return lhs == rhs && equalChains(lhs.next, rhs.next); }
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -0,0 +1,346 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::SwapchainRing, which enumerates swapchain images once and acquires and waits for them on a
+ * helper thread.
+ *
+ * @see xr::SwapchainRing
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_span.hpp"
+#include "openxr_structs.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Enumerates the images of a swapchain once, and acquires and waits for each on a helper thread, so the render
+ * thread only calls xrReleaseSwapchainImage.
+ *
+ * @p ImageType is the graphics API's image struct, such as xr::SwapchainImageVulkanKHR. The images are enumerated by
+ * start() into storage that is not reallocated afterwards, so references returned by image() and images() stay valid.
+ *
+ * The helper thread acquires the next image as soon as the render thread has taken the last one, a frame early,
+ * then waits for it once the last one is released: OpenXR allows only one image to be waited for and not released.
+ * xrWaitSwapchainImage is called with a bounded timeout, repeated until the image is ready, so that stop() returns
+ * within that timeout. With a single image, as for static swapchains, it is acquired once released instead.
+ *
+ * ```{.cpp}
+ * xr::SwapchainRing<xr::SwapchainImageVulkanKHR> ring{swapchain};
+ * ring.start();
+ * uint32_t index;
+ * while (ring.acquire(index)) {
+ *     // ... render to ring.image(index).image
+ *     ring.release();
+ * }
+ * // ring.lastResult() says why the helper thread stopped.
+ * ```
+ *
+ * The swapchain is used from both threads, and calls on it are serialized. Only release() may be called while the
+ * render thread holds an image, and a single image may be held at once.
+ *
+ * @ingroup utilities
+ */
+template <typename ImageType, typename Dispatch OPENXR_HPP_DEFAULT_CORE_DISPATCH_TYPE_ARG>
+class SwapchainRing {
+    static_assert(std::is_base_of<SwapchainImageBaseHeader, ImageType>::value,
+                  "SwapchainRing requires a swapchain image type");
+
+   public:
+    /*!
+     * @brief Constructor: the swapchain is not owned. The dispatch is copied, for use on both threads.
+     *
+     * Each call to xrWaitSwapchainImage times out after 1 millisecond.
+     */
+    explicit SwapchainRing(Swapchain swapchain, Dispatch d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG)
+        : SwapchainRing(swapchain, Duration{1000000}, std::move(d)) {}
+
+    //! Constructor: each call to xrWaitSwapchainImage times out after @p waitTimeout.
+    SwapchainRing(Swapchain swapchain, Duration waitTimeout, Dispatch d OPENXR_HPP_DEFAULT_CORE_DISPATCH_ARG)
+        : m_swapchain(swapchain), m_waitTimeout(waitTimeout), m_dispatch(std::move(d)) {}
+
+    SwapchainRing(SwapchainRing const&) = delete;
+    SwapchainRing& operator=(SwapchainRing const&) = delete;
+
+    //! Stops the helper thread: see stop().
+    ~SwapchainRing() { stop(); }
+
+    /*!
+     * @brief Enumerates the images, the first time, and starts the helper thread, if not running.
+     *
+     * @return the failure of xrEnumerateSwapchainImages, in which case the thread is not started, or Result::Success.
+     */
+    Result start() {
+        if (m_thread.joinable()) {
+            return Result::Success;
+        }
+        if (m_images.empty()) {
+            const Result result = enumerate();
+            if (!succeeded(result)) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_result = result;
+                return result;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = false;
+            m_result = Result::Success;
+        }
+        m_thread = std::thread([this] { run(); });
+        return Result::Success;
+    }
+
+    /*!
+     * @brief Stop the helper thread, within the wait timeout, and wake acquire().
+     *
+     * An image acquired or waited for but not yet taken stays so, and is the next returned once started again.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_changed.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /*!
+     * @brief Render thread: wait for the next image to be ready to render to, and take it.
+     *
+     * @return false if the ring was stopped, or a call on the swapchain failed: see lastResult().
+     */
+    bool acquire(uint32_t& index) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            OPENXR_HPP_ASSERT(!m_held);
+            m_changed.wait(lock, [this] { return m_pending == Pending::Ready || m_stopping; });
+            if (m_pending != Pending::Ready) {
+                return false;
+            }
+            take(index);
+        }
+        m_changed.notify_all();
+        return true;
+    }
+
+    //! Render thread: take the next image if it is ready to render to, without waiting.
+    bool tryAcquire(uint32_t& index) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            OPENXR_HPP_ASSERT(!m_held);
+            if (m_pending != Pending::Ready) {
+                return false;
+            }
+            take(index);
+        }
+        m_changed.notify_all();
+        return true;
+    }
+
+    //! Render thread: call xrReleaseSwapchainImage for the image taken by acquire().
+    Result release() {
+        const SwapchainImageReleaseInfo releaseInfo;
+        Result result;
+        {
+            std::lock_guard<std::mutex> lock(m_callMutex);
+            result = static_cast<Result>(m_dispatch.xrReleaseSwapchainImage(m_swapchain.get(), releaseInfo.get()));
+        }
+        if (succeeded(result)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_held = false;
+            }
+            m_changed.notify_all();
+        }
+        return result;
+    }
+
+    //! The number of images, once started.
+    uint32_t size() const noexcept { return static_cast<uint32_t>(m_images.size()); }
+
+    //! The image at @p index, as returned by acquire().
+    ImageType const& image(uint32_t index) const noexcept {
+        OPENXR_HPP_ASSERT(index < m_images.size());
+        return m_images[index];
+    }
+
+    //! All images, once started.
+    Span<const ImageType> images() const noexcept { return {m_images.data(), m_images.size()}; }
+
+    //! The failure that stopped the helper thread, or Result::Success.
+    Result lastResult() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_result;
+    }
+
+   private:
+    //! The state of the next image, advanced by the helper thread up to Ready, and by take() back to None.
+    enum class Pending { None, Acquired, Ready };
+
+    //! With the lock held: hand the ready image to the render thread.
+    void take(uint32_t& index) {
+        index = m_index;
+        m_pending = Pending::None;
+        m_held = true;
+    }
+
+    Result enumerate() {
+        uint32_t count = 0;
+        Result result =
+            static_cast<Result>(m_dispatch.xrEnumerateSwapchainImages(m_swapchain.get(), 0, &count, nullptr));
+        if (!succeeded(result) || count == 0) {
+            return result;
+        }
+        m_images.resize(count);
+        result = static_cast<Result>(m_dispatch.xrEnumerateSwapchainImages(
+            m_swapchain.get(), count, &count, reinterpret_cast<XrSwapchainImageBaseHeader*>(m_images.data())));
+        if (succeeded(result)) {
+            m_images.resize(count);
+        } else {
+            m_images.clear();
+        }
+        return result;
+    }
+
+    //! Sleep until @p condition holds: returns false if stopping instead.
+    template <typename Condition>
+    bool waitUntil(Condition condition) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [&] { return m_stopping || condition(); });
+        return !m_stopping;
+    }
+
+    //! Record the failure that stops the helper thread, and wake acquire().
+    void fail(Result result) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_result = result;
+            m_stopping = true;
+        }
+        m_changed.notify_all();
+    }
+
+    void run() {
+        const bool ahead = m_images.size() > 1;
+        const SwapchainImageAcquireInfo acquireInfo;
+        const SwapchainImageWaitInfo waitInfo{m_waitTimeout};
+        for (;;) {
+            Pending pending;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                pending = m_pending;
+            }
+            if (pending == Pending::None) {
+                if (!ahead && !waitUntil([this] { return !m_held; })) {
+                    return;
+                }
+                uint32_t index = 0;
+                Result result;
+                {
+                    std::lock_guard<std::mutex> lock(m_callMutex);
+                    result = static_cast<Result>(
+                        m_dispatch.xrAcquireSwapchainImage(m_swapchain.get(), acquireInfo.get(), &index));
+                }
+                if (!succeeded(result)) {
+                    fail(result);
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_index = index;
+                m_pending = pending = Pending::Acquired;
+            }
+            if (pending == Pending::Acquired) {
+                if (!waitUntil([this] { return !m_held; })) {
+                    return;
+                }
+                Result result;
+                do {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (m_stopping) {
+                            return;
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(m_callMutex);
+                    result = static_cast<Result>(m_dispatch.xrWaitSwapchainImage(m_swapchain.get(), waitInfo.get()));
+                } while (result == Result::TimeoutExpired);
+                if (!succeeded(result)) {
+                    fail(result);
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pending = Pending::Ready;
+                }
+                m_changed.notify_all();
+            }
+            if (!waitUntil([this] { return m_pending != Pending::Ready; })) {
+                return;
+            }
+        }
+    }
+
+    Swapchain m_swapchain;
+    Duration m_waitTimeout;
+    Dispatch m_dispatch;
+    std::vector<ImageType> m_images;
+    std::thread m_thread;
+    //! Serializes calls on the swapchain between the two threads.
+    std::mutex m_callMutex;
+    //! Guards everything below, and nothing above.
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    Pending m_pending = Pending::None;
+    uint32_t m_index = 0;
+    bool m_held = false;
+    bool m_stopping = true;
+    Result m_result = Result::Success;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
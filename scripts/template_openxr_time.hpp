@@ -46,8 +46,34 @@
  * @ingroup wrappers
  */
 #include "openxr_duration.hpp"
+
+#include <chrono>
 //# endblock
 
+//# block member_types
+/*!
+ * @brief The clock of XrTime values, for use as the clock of a std::chrono::time_point.
+ *
+ * It has no `now()`: only the runtime can tell the time, e.g. through xr::TimeConverter.
+ */
+struct Clock {
+    using rep = XrTime;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<Clock>;
+    static constexpr bool is_steady = true;
+};
+//# endblock member_types
+
+//# block extra_constructors_conversion_assign
+
+//! Explicit conversion from a time point of the XrTime clock, truncated to nanoseconds.
+template <typename ChronoDuration>
+OPENXR_HPP_CONSTEXPR explicit Time(std::chrono::time_point<Clock, ChronoDuration> t) noexcept
+    : val_(std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count()) {}
+
+//# endblock extra_constructors_conversion_assign
+
 //# block conversion_explicit_bool
 //! True if this time is valid (positive)
 OPENXR_HPP_CONSTEXPR explicit operator bool() const noexcept { return val_ > 0; }
@@ -59,6 +85,9 @@ OPENXR_HPP_CONSTEXPR bool operator!() const noexcept { return val_ <= 0; }
 //# endblock
 
 //# block extra_methods
+//! Conversion to a time point of the XrTime clock.
+OPENXR_HPP_CONSTEXPR Clock::time_point toChrono() const noexcept { return Clock::time_point{Clock::duration{val_}}; }
+
 //! Add a Duration to the current Time
 Time& operator+=(Duration d) noexcept {
     val_ += d.get();
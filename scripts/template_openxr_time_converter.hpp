@@ -0,0 +1,242 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::TimeConverter, for converting between XrTime and std::chrono::steady_clock without calling the
+ * runtime for every conversion.
+ *
+ * Requires XR_KHR_convert_timespec_time: define XR_USE_TIMESPEC and include `<time.h>` before including this header.
+ *
+ * @see xr::TimeConverter
+ * @ingroup utilities
+ */
+
+#include "openxr_handles.hpp"
+#include "openxr_time.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+#if defined(XR_USE_TIMESPEC) || defined(OPENXR_HPP_DOXYGEN)
+/*!
+ * @brief Converts between XrTime and std::chrono::steady_clock locally, from the offset between them sampled with
+ * xrConvertTimespecTimeToTimeKHR now and then.
+ *
+ * Each sample() calls the runtime once. In between, conversions are plain arithmetic, using the offset at the last
+ * sample and the drift between the clocks measured over the last two samples. Call update() regularly, e.g. once per
+ * frame: it samples again once the resample interval has passed.
+ *
+ * ```{.cpp}
+ * xr::TimeConverter converter{instance};
+ * converter.sample(dispatch);
+ * // Once per frame:
+ * converter.update(dispatch);
+ * // For each sensor reading:
+ * xr::Time time = converter.toTime(reading.timestamp);
+ * ```
+ *
+ * sample() and update() dispatch to an extension, so they default to `OPENXR_HPP_DEFAULT_EXTENSION_DISPATCHER`.
+ *
+ * Requires steady_clock to be CLOCK_MONOTONIC, the clock of XR_KHR_convert_timespec_time, as it is with libstdc++
+ * and libc++ on Linux and Android.
+ *
+ * Conversions may be called from any thread, also while another samples: each sample is published through a sequence
+ * lock, so a conversion uses the offset, reference times and drift of one sample, never a mix of two. sample() and
+ * update() must be called from one thread at a time.
+ *
+ * @ingroup utilities
+ */
+class TimeConverter {
+   public:
+    using SteadyTimePoint = std::chrono::steady_clock::time_point;
+
+    //! Constructor: the instance is not owned.
+    explicit TimeConverter(Instance instance,
+                           std::chrono::nanoseconds resampleInterval = std::chrono::seconds(1)) noexcept
+        : m_instance(instance), m_resampleInterval(resampleInterval) {}
+
+    /*!
+     * @brief Sample the offset between the clocks at @p now, with one call to xrConvertTimespecTimeToTimeKHR.
+     *
+     * On failure, conversions keep using the previous samples.
+     *
+     * @return The result of xrConvertTimespecTimeToTimeKHR.
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_EXT_DISPATCH_TYPE_ARG>
+    Result sample(SteadyTimePoint now, Dispatch&& d OPENXR_HPP_DEFAULT_EXT_DISPATCH_ARG) noexcept {
+        const int64_t steady = nanoseconds(now);
+        timespec ts;
+        ts.tv_sec = static_cast<decltype(ts.tv_sec)>(steady / 1000000000);
+        ts.tv_nsec = static_cast<decltype(ts.tv_nsec)>(steady % 1000000000);
+        XrTime runtime = 0;
+        const Result result = static_cast<Result>(d.xrConvertTimespecTimeToTimeKHR(m_instance.get(), &ts, &runtime));
+        if (!succeeded(result)) {
+            return result;
+        }
+        Snapshot next = load();
+        if (next.sampled) {
+            m_lastError.store(runtime - toTime(now, next).get());
+            const int64_t elapsed = steady - next.steady;
+            if (elapsed > 0) {
+                // Drift over the whole interval, so a runtime that adjusts its clock is followed from now on.
+                next.drift = static_cast<double>((runtime - next.runtime) - elapsed) / static_cast<double>(elapsed);
+            }
+        }
+        next.sampled = true;
+        next.steady = steady;
+        next.runtime = runtime;
+        store(next);
+        return result;
+    }
+
+    //! @brief Sample the offset between the clocks now: see sample(SteadyTimePoint, Dispatch&&).
+    template <typename Dispatch OPENXR_HPP_DEFAULT_EXT_DISPATCH_TYPE_ARG>
+    Result sample(Dispatch&& d OPENXR_HPP_DEFAULT_EXT_DISPATCH_ARG) noexcept {
+        return sample(std::chrono::steady_clock::now(), d);
+    }
+
+    /*!
+     * @brief Sample at @p now if there is no sample yet, or the resample interval has passed since the last.
+     *
+     * @return Result::Success if no sample was due, else the result of sample().
+     */
+    template <typename Dispatch OPENXR_HPP_DEFAULT_EXT_DISPATCH_TYPE_ARG>
+    Result update(SteadyTimePoint now, Dispatch&& d OPENXR_HPP_DEFAULT_EXT_DISPATCH_ARG) noexcept {
+        const Snapshot last = load();
+        if (last.sampled && nanoseconds(now) - last.steady < m_resampleInterval.count()) {
+            return Result::Success;
+        }
+        return sample(now, d);
+    }
+
+    //! @brief Sample now if due: see update(SteadyTimePoint, Dispatch&&).
+    template <typename Dispatch OPENXR_HPP_DEFAULT_EXT_DISPATCH_TYPE_ARG>
+    Result update(Dispatch&& d OPENXR_HPP_DEFAULT_EXT_DISPATCH_ARG) noexcept {
+        return update(std::chrono::steady_clock::now(), d);
+    }
+
+    //! Convert @p t to XrTime. Before the first sample, the clocks are taken to be the same.
+    Time toTime(SteadyTimePoint t) const noexcept { return toTime(t, load()); }
+
+    //! Convert @p time to steady_clock. Before the first sample, the clocks are taken to be the same.
+    SteadyTimePoint toSteadyClock(Time time) const noexcept {
+        const Snapshot last = load();
+        // Invert toTime(): elapsed runtime time is elapsed steady time scaled by (1 + drift).
+        const int64_t elapsed = time.get() - last.runtime;
+        const int64_t corrected = correction(elapsed, last.drift);
+        const int64_t steady = last.steady + elapsed - corrected + correction(corrected, last.drift);
+        return SteadyTimePoint{std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds{steady})};
+    }
+
+    //! Whether the clocks have been sampled successfully at least once.
+    bool sampled() const noexcept { return load().sampled; }
+
+    //! How far the XrTime predicted for the last sample was from the runtime's: zero until the second sample.
+    Duration lastError() const noexcept { return Duration{m_lastError.load()}; }
+
+    //! The measured rate of the runtime clock relative to steady_clock, less one.
+    double drift() const noexcept { return load().drift; }
+
+   private:
+    //! What conversions use, as of one sample.
+    struct Snapshot {
+        bool sampled;
+        int64_t steady;
+        XrTime runtime;
+        double drift;
+    };
+
+    static int64_t nanoseconds(SteadyTimePoint t) noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    static int64_t correction(int64_t elapsed, double drift) noexcept {
+        return static_cast<int64_t>(std::llround(static_cast<double>(elapsed) * drift));
+    }
+
+    static Time toTime(SteadyTimePoint t, Snapshot const& last) noexcept {
+        const int64_t elapsed = nanoseconds(t) - last.steady;
+        return Time{last.runtime + elapsed + correction(elapsed, last.drift)};
+    }
+
+    /*!
+     * @brief Read the last sample published, retrying while one is being published.
+     *
+     * The sequence is odd while store() is writing. All accesses are sequentially consistent, so if the sequence
+     * is even and the same before and after reading the fields, they all come from the same store().
+     */
+    Snapshot load() const noexcept {
+        for (;;) {
+            const uint32_t sequence = m_sequence.load();
+            Snapshot snapshot;
+            snapshot.sampled = m_sampled.load();
+            snapshot.steady = m_steady.load();
+            snapshot.runtime = m_runtime.load();
+            snapshot.drift = m_drift.load();
+            if ((sequence & 1) == 0 && m_sequence.load() == sequence) {
+                return snapshot;
+            }
+        }
+    }
+
+    //! Publish a sample: only called by sample(), from one thread at a time.
+    void store(Snapshot const& snapshot) noexcept {
+        const uint32_t sequence = m_sequence.load();
+        m_sequence.store(sequence + 1);
+        m_sampled.store(snapshot.sampled);
+        m_steady.store(snapshot.steady);
+        m_runtime.store(snapshot.runtime);
+        m_drift.store(snapshot.drift);
+        m_sequence.store(sequence + 2);
+    }
+
+    Instance m_instance;
+    std::chrono::nanoseconds m_resampleInterval;
+    std::atomic<uint32_t> m_sequence{0};
+    std::atomic<bool> m_sampled{false};
+    std::atomic<int64_t> m_steady{0};
+    std::atomic<XrTime> m_runtime{0};
+    std::atomic<double> m_drift{0.};
+    std::atomic<XrDuration> m_lastError{0};
+};
+#endif  // defined(XR_USE_TIMESPEC) || defined(OPENXR_HPP_DOXYGEN)
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
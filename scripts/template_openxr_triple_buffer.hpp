@@ -0,0 +1,111 @@
+//## Copyright (c) 2017-2019 The Khronos Group Inc.
+//## Copyright (c) 2019 Collabora, Ltd.
+//##
+//## Licensed under the Apache License, Version 2.0 (the "License");
+//## you may not use this file except in compliance with the License.
+//## You may obtain a copy of the License at
+//##
+//##     http://www.apache.org/licenses/LICENSE-2.0
+//##
+//## Unless required by applicable law or agreed to in writing, software
+//## distributed under the License is distributed on an "AS IS" BASIS,
+//## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//## See the License for the specific language governing permissions and
+//## limitations under the License.
+//##
+//## ---- Exceptions to the Apache 2.0 License: ----
+//##
+//## As an exception, if you use this Software to generate code and portions of
+//## this Software are embedded into the generated code as a result, you may
+//## redistribute such product without providing attribution as would otherwise
+//## be required by Sections 4(a), 4(b) and 4(d) of the License.
+//##
+//## In addition, if you combine or link code generated by this Software with
+//## software that is licensed under the GPLv2 or the LGPL v2.0 or 2.1
+//## ("`Combined Software`") and if a court of competent jurisdiction determines
+//## that the patent provision (Section 3), the indemnity provision (Section 9)
+//## or other Section of the License conflicts with the conditions of the
+//## applicable GPL or LGPL license, you may retroactively and prospectively
+//## choose to deem waived or otherwise exclude such Section(s) of the License,
+//## but only in their entirety and only with respect to the Combined Software.
+
+
+//# include('file_header.hpp')
+/**
+ * @file
+ * @brief Contains xr::TripleBuffer, for handing the latest value from one thread to another without locking.
+ *
+ * @see xr::TripleBuffer
+ * @ingroup utilities
+ */
+
+//# include('define_namespace.hpp') without context
+
+#include <atomic>
+#include <cstdint>
+
+namespace OPENXR_HPP_NAMESPACE {
+
+/*!
+ * @brief Three values of type @p T, through which one writer thread hands the latest value to one reader thread
+ * without either ever waiting for the other.
+ *
+ * The writer fills in back() and calls publish(); the reader calls update(), then reads front(). Values published
+ * while the reader is not looking are overwritten, never queued: the reader always gets the latest.
+ *
+ * ```{.cpp}
+ * xr::TripleBuffer<Stats> stats;
+ * // Writer:
+ * stats.back() = currentStats;
+ * stats.publish();
+ * // Reader:
+ * if (stats.update()) { exportStats(stats.front()); }
+ * ```
+ *
+ * @ingroup utilities
+ */
+template <typename T>
+class TripleBuffer {
+   public:
+    TripleBuffer() = default;
+    TripleBuffer(TripleBuffer const&) = delete;
+    TripleBuffer& operator=(TripleBuffer const&) = delete;
+
+    //! Writer: the value to fill in before publish(). After publish(), this is another buffer, holding an older value.
+    T& back() noexcept { return m_buffers[m_back]; }
+
+    //! Writer: make back() the latest value, and get a new back().
+    void publish() noexcept {
+        const uint8_t published = static_cast<uint8_t>(m_back | fresh);
+        m_back = static_cast<uint8_t>(m_middle.exchange(published, std::memory_order_acq_rel) & indexMask);
+    }
+
+    //! Reader: if a value was published since the last call, make it front(). Returns whether there was one.
+    bool update() noexcept {
+        if ((m_middle.load(std::memory_order_relaxed) & fresh) == 0) {
+            return false;
+        }
+        m_front = static_cast<uint8_t>(m_middle.exchange(m_front, std::memory_order_acq_rel) & indexMask);
+        return true;
+    }
+
+    //! Reader: the latest value as of the last update(), or a default-constructed T before the first.
+    T const& front() const noexcept { return m_buffers[m_front]; }
+
+   private:
+    static constexpr uint8_t indexMask = 0x3;
+    //! Set in m_middle when it holds a value the reader has not taken yet.
+    static constexpr uint8_t fresh = 0x4;
+
+    T m_buffers[3]{};
+    //! Owned by the writer.
+    uint8_t m_back = 0;
+    //! Shared: the index of the buffer between writer and reader, and whether it is fresh.
+    std::atomic<uint8_t> m_middle{1};
+    //! Owned by the reader.
+    uint8_t m_front = 2;
+};
+
+}  // namespace OPENXR_HPP_NAMESPACE
+
+//# include('file_footer.hpp')
@@ -37,6 +37,9 @@
 //#     block includes
 //#     endblock includes
 
+#include <cstddef>
+#include <functional>
+
 //#     block defines
 //#     include('define_inline_constexpr.hpp')
 //#     include('define_namespace.hpp')
@@ -49,5 +52,15 @@ namespace OPENXR_HPP_NAMESPACE {
 
 } // OPENXR_HPP_NAMESPACE
 
+#ifndef OPENXR_HPP_DOXYGEN
+namespace std {
+//! Hash specialization, for /*{ type }*/ keys of unordered containers.
+template <>
+struct hash<OPENXR_HPP_NAMESPACE::/*{ type }*/> {
+    size_t operator()(OPENXR_HPP_NAMESPACE::/*{ type }*/ const& v) const noexcept { return hash</*{ raw_type }*/>{}(v.get()); }
+};
+}  // namespace std
+#endif  // !OPENXR_HPP_DOXYGEN
+
 //# include 'file_footer.hpp'
 //# endblock suffix
@@ -3,3 +3,11 @@
 #include "xr_dependencies.h"
 
 static xr::DispatchLoaderDynamic xr_dispatch{};
+
+// Dispatch trampolines never throw.
+static_assert(noexcept(xr_dispatch.xrPollEvent(XR_NULL_HANDLE, nullptr)), "dispatch should be noexcept");
+// Enhanced wrappers throw on error when exceptions are enabled.
+static_assert(!noexcept(std::declval<xr::Instance&>().pollEvent(std::declval<xr::EventDataBuffer&>())),
+              "enhanced wrapper may throw");
+static_assert(!noexcept(std::declval<xr::Instance&>().createSession(std::declval<xr::SessionCreateInfo const&>())),
+              "enhanced wrapper may throw");
@@ -2,3 +2,10 @@
 
 #include "openxr/openxr.hpp"
 #include "xr_dependencies.h"
+
+// Basic wrappers only forward to the (noexcept) dispatch.
+static_assert(noexcept(std::declval<xr::Instance&>().pollEvent(std::declval<xr::EventDataBuffer&>())),
+              "basic wrapper should be noexcept");
+static_assert(noexcept(std::declval<xr::Instance&>().createSession(std::declval<xr::SessionCreateInfo const&>(),
+                                                                     std::declval<xr::Session&>())),
+              "basic wrapper should be noexcept");
@@ -0,0 +1,108 @@
+// Compares the xr::math joint kernels against their one-joint-at-a-time versions in xr::math::scalar,
+// over 10000 hands. Build with optimizations, e.g. -O2. The tests build it with SSE4.1 (AVX under MSVC) when the
+// compiler supports it; pass another instruction set, e.g. -mavx2, to measure that one instead.
+
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_joints.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+constexpr size_t kHands = 10000;
+constexpr size_t kJoints = 26;
+constexpr int kRepetitions = 20;
+
+using Hand = std::array<xr::HandJointLocationEXT, kJoints>;
+using Joints = xr::math::JointBatch<kJoints>;
+using Bones = xr::math::BoneBatch<kJoints>;
+
+std::vector<Hand> makeHands() {
+    const xr::SpaceLocationFlags valid =
+        xr::SpaceLocationFlagBits::OrientationValid | xr::SpaceLocationFlagBits::PositionValid;
+    std::vector<Hand> hands(kHands);
+    for (size_t h = 0; h < kHands; ++h) {
+        for (size_t i = 0; i < kJoints; ++i) {
+            const float f = static_cast<float>(h + i);
+            xr::HandJointLocationEXT& joint = hands[h][i];
+            // Every seventh joint untracked, to exercise the masks.
+            joint.locationFlags = (h + i) % 7 == 0 ? xr::SpaceLocationFlags{} : valid;
+            joint.pose = xr::Posef{xr::math::scalar::normalize({0.01f * f, 0.5f, -0.02f * f, 1.f}),
+                                   {0.001f * f, 0.002f * f, -0.3f}};
+        }
+    }
+    return hands;
+}
+
+// Prevent the optimizer from discarding results.
+volatile float g_sink;
+
+template <typename F>
+void run(const char* name, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    float total = 0.f;
+    for (int r = 0; r < kRepetitions; ++r) {
+        total += f();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = total;
+    const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::printf("%-32s %8.2f ns/hand\n", name, ns / (double(kRepetitions) * kHands));
+}
+}  // namespace
+
+int main() {
+#if defined(OPENXR_HPP_MATH_SSE4)
+    std::printf("xr::math uses SSE4.1\n");
+#elif defined(OPENXR_HPP_MATH_NEON)
+    std::printf("xr::math uses NEON\n");
+#else
+    std::printf("xr::math uses scalar code\n");
+#endif
+
+    const std::vector<Hand> hands = makeHands();
+    std::vector<Hand> transformed = hands;
+    std::vector<Joints> joints(kHands);
+    std::vector<Bones> bones(kHands);
+    const xr::Posef stageInWorld{xr::math::scalar::normalize({0.f, 0.6f, 0.f, 0.8f}), {2.f, 0.f, -1.f}};
+
+    run("loadJoints", [&] {
+        for (size_t h = 0; h < kHands; ++h) {
+            xr::math::loadJoints(xr::Span<const xr::HandJointLocationEXT>(hands[h]), joints[h]);
+        }
+        return joints[kHands - 1].positionX[0];
+    });
+    run("scalar::compose per joint", [&] {
+        for (size_t h = 0; h < kHands; ++h) {
+            for (size_t i = 0; i < kJoints; ++i) {
+                if (hands[h][i].locationFlags) {
+                    transformed[h][i].pose = xr::math::scalar::compose(stageInWorld, hands[h][i].pose);
+                }
+            }
+        }
+        return transformed[kHands - 1][1].pose.position.x;
+    });
+    run("scalar::transformJoints", [&] {
+        for (size_t h = 0; h < kHands; ++h) xr::math::scalar::transformJoints(stageInWorld, joints[h]);
+        return joints[kHands - 1].positionX[1];
+    });
+    run("transformJoints", [&] {
+        for (size_t h = 0; h < kHands; ++h) xr::math::transformJoints(stageInWorld, joints[h]);
+        return joints[kHands - 1].positionX[1];
+    });
+    run("scalar::computeBones", [&] {
+        for (size_t h = 0; h < kHands; ++h) {
+            xr::math::scalar::computeBones(joints[h], xr::math::handJointParents(), bones[h]);
+        }
+        return bones[kHands - 1].length[2];
+    });
+    run("computeBones", [&] {
+        for (size_t h = 0; h < kHands; ++h) {
+            xr::math::computeBones(joints[h], xr::math::handJointParents(), bones[h]);
+        }
+        return bones[kHands - 1].length[2];
+    });
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Compares xr::math against its plain C++ reference, xr::math::scalar.
+// Build with optimizations, e.g. -O2. The tests build it with SSE4.1 (AVX under MSVC) when the compiler supports it;
+// pass another instruction set, e.g. -mavx2, to measure that one instead.
+
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_math.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+constexpr size_t kCount = 4096;
+constexpr int kRepetitions = 2000;
+
+std::vector<xr::Posef> makePoses() {
+    std::vector<xr::Posef> poses;
+    poses.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        poses.emplace_back(xr::math::scalar::normalize({0.1f * f, 1.f - 0.2f * f, 0.3f, 1.f + 0.05f * f}),
+                           xr::Vector3f{f, -f, 0.5f * f});
+    }
+    return poses;
+}
+
+// Prevent the optimizer from discarding results.
+volatile float g_sink;
+
+template <typename F>
+void run(const char* name, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    float total = 0.f;
+    for (int r = 0; r < kRepetitions; ++r) {
+        total += f();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = total;
+    const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::printf("%-32s %8.2f ns/op\n", name, ns / (double(kRepetitions) * kCount));
+}
+}  // namespace
+
+int main() {
+#if defined(OPENXR_HPP_MATH_SSE4)
+    std::printf("xr::math uses SSE4.1\n");
+#elif defined(OPENXR_HPP_MATH_NEON)
+    std::printf("xr::math uses NEON\n");
+#else
+    std::printf("xr::math uses scalar code\n");
+#endif
+
+    const std::vector<xr::Posef> poses = makePoses();
+    std::vector<xr::Posef> out(kCount);
+    const xr::Posef parent = poses[kCount / 2];
+    const xr::Vector3f point{0.5f, 1.f, -2.f};
+
+    run("scalar::compose", [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = xr::math::scalar::compose(parent, poses[i]);
+        return out[kCount - 1].position.x;
+    });
+    run("compose", [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = xr::math::compose(parent, poses[i]);
+        return out[kCount - 1].position.x;
+    });
+    run("scalar::invert", [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = xr::math::scalar::invert(poses[i]);
+        return out[kCount - 1].position.x;
+    });
+    run("invert", [&] {
+        for (size_t i = 0; i < kCount; ++i) out[i] = xr::math::invert(poses[i]);
+        return out[kCount - 1].position.x;
+    });
+    run("scalar::transformPoint", [&] {
+        float sum = 0.f;
+        for (size_t i = 0; i < kCount; ++i) {
+            const xr::Vector3f v = xr::math::scalar::transformPoint(poses[i], point);
+            sum += v.x + v.y + v.z;
+        }
+        return sum;
+    });
+    run("transformPoint", [&] {
+        float sum = 0.f;
+        for (size_t i = 0; i < kCount; ++i) {
+            const xr::Vector3f v = xr::math::transformPoint(poses[i], point);
+            sum += v.x + v.y + v.z;
+        }
+        return sum;
+    });
+    run("scalar::slerp", [&] {
+        float sum = 0.f;
+        for (size_t i = 0; i + 1 < kCount; ++i)
+            sum += xr::math::scalar::slerp(poses[i].orientation, poses[i + 1].orientation, 0.25f).w;
+        return sum;
+    });
+    run("slerp", [&] {
+        float sum = 0.f;
+        for (size_t i = 0; i + 1 < kCount; ++i)
+            sum += xr::math::slerp(poses[i].orientation, poses[i + 1].orientation, 0.25f).w;
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Compares a serializer written with xr::forEachField against copying the whole struct with memcpy.
+// Build with optimizations, e.g. -O2.
+
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_reflection.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr size_t kCount = 4096;
+constexpr int kRepetitions = 2000;
+
+// Writes every member but the pointers, packed, as a reflection-based serializer would.
+template <typename T>
+size_t serialize(T const& s, unsigned char* out) {
+    size_t offset = 0;
+    xr::forEachField(s, [&](xr::FieldDescriptor const& field, auto const& value) {
+        if (!field.isPointer) {
+            std::memcpy(out + offset, &value, sizeof(value));
+            offset += sizeof(value);
+        }
+    });
+    return offset;
+}
+
+// The same by name, to tell the cost of the reflection from that of copying member by member.
+size_t serializeByName(xr::SpaceLocation const& s, unsigned char* out) {
+    const XrSpaceLocation& raw = *s.get();
+    std::memcpy(out, &raw.type, sizeof(raw.type));
+    std::memcpy(out + sizeof(raw.type), &raw.locationFlags, sizeof(raw.locationFlags));
+    std::memcpy(out + sizeof(raw.type) + sizeof(raw.locationFlags), &raw.pose, sizeof(raw.pose));
+    return sizeof(raw.type) + sizeof(raw.locationFlags) + sizeof(raw.pose);
+}
+
+// Prevent the optimizer from discarding results.
+volatile unsigned char g_sink;
+
+template <typename F>
+double run(const char* name, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    unsigned total = 0;
+    for (int r = 0; r < kRepetitions; ++r) {
+        total += f();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    g_sink = static_cast<unsigned char>(total);
+    const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / (double(kRepetitions) * kCount);
+    std::printf("%-32s %8.2f ns/op\n", name, ns);
+    return ns;
+}
+
+template <typename T>
+void compare(const char* memcpyName, const char* reflectionName, std::vector<T> const& structs) {
+    std::vector<unsigned char> buffer(kCount * sizeof(T));
+    const double copied = run(memcpyName, [&] {
+        for (size_t i = 0; i < kCount; ++i) std::memcpy(buffer.data() + i * sizeof(T), &structs[i], sizeof(T));
+        return buffer[buffer.size() - 1];
+    });
+    const double serialized = run(reflectionName, [&] {
+        size_t offset = 0;
+        for (size_t i = 0; i < kCount; ++i) offset += serialize(structs[i], buffer.data() + offset);
+        return buffer[offset - 1];
+    });
+    std::printf("%-32s %8.2f\n", "  ratio", serialized / copied);
+}
+}  // namespace
+
+int main() {
+    std::vector<xr::SpaceLocation> locations(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        const float f = static_cast<float>(i);
+        locations[i].locationFlags = xr::SpaceLocationFlagBits::PositionValid;
+        locations[i].pose = xr::Posef{xr::Quaternionf{0.f, 0.f, 0.f, 1.f}, xr::Vector3f{f, -f, 0.5f * f}};
+    }
+    compare("memcpy SpaceLocation", "forEachField SpaceLocation", locations);
+    std::vector<unsigned char> buffer(kCount * sizeof(xr::SpaceLocation));
+    run("by name SpaceLocation", [&] {
+        size_t offset = 0;
+        for (size_t i = 0; i < kCount; ++i) offset += serializeByName(locations[i], buffer.data() + offset);
+        return buffer[offset - 1];
+    });
+
+    std::vector<xr::SystemProperties> properties(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        std::snprintf(properties[i].systemName, sizeof(properties[i].systemName), "System %u", unsigned(i));
+        properties[i].vendorId = static_cast<uint32_t>(i);
+    }
+    compare("memcpy SystemProperties", "forEachField SystemProperties", properties);
+    return 0;
+}
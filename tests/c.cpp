@@ -2,3 +2,8 @@
 
 #include "openxr/openxr.hpp"
 #include "xr_dependencies.h"
+
+static_assert(!noexcept(std::declval<xr::Instance&>().createSession(std::declval<xr::SessionCreateInfo const&>())),
+              "enhanced wrapper may throw");
+static_assert(!noexcept(std::declval<xr::Session&>().beginFrame(std::declval<xr::FrameBeginInfo const&>())),
+              "enhanced wrapper may throw");
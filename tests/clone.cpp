@@ -0,0 +1,119 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_clone.hpp"
+#include "openxr/openxr_structure_chain.hpp"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+class OpenXrCloneTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    depthInfo.nearZ = 0.1f;
+    views[0].next = &depthInfo;
+    views[1].subImage.imageArrayIndex = 1;
+    projection.viewCount = 2;
+    projection.views = views;
+    layers[0] = &projection;
+    layers[1] = &quad;
+    frameEndInfo.displayTime = xr::Time{42};
+    frameEndInfo.layerCount = 2;
+    frameEndInfo.layers = layers;
+  }
+
+  void TearDown() override {}
+
+  xr::CompositionLayerDepthInfoKHR depthInfo;
+  xr::CompositionLayerProjectionView views[2];
+  xr::CompositionLayerProjection projection;
+  xr::CompositionLayerQuad quad;
+  const xr::CompositionLayerBaseHeader *layers[2];
+  xr::FrameEndInfo frameEndInfo;
+
+  alignas(16) unsigned char buffer[2048];
+};
+
+TEST_F(OpenXrCloneTest, frameEndInfoIsDeep) {
+  xr::Arena arena{buffer, sizeof(buffer)};
+  const xr::FrameEndInfo *copy = xr::cloneDeep(frameEndInfo, arena);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_NE(copy, &frameEndInfo);
+  EXPECT_EQ(copy->displayTime.get(), 42);
+  ASSERT_EQ(copy->layerCount, 2u);
+  EXPECT_NE(copy->layers, layers);
+
+  ASSERT_EQ(copy->layers[0]->type, xr::StructureType::CompositionLayerProjection);
+  auto *projectionCopy = static_cast<const xr::CompositionLayerProjection *>(copy->layers[0]);
+  EXPECT_NE(projectionCopy, &projection);
+  ASSERT_EQ(projectionCopy->viewCount, 2u);
+  EXPECT_NE(projectionCopy->views, views);
+  EXPECT_EQ(projectionCopy->views[1].subImage.imageArrayIndex, 1u);
+
+  auto *depthInfoCopy = xr::findInChain<xr::CompositionLayerDepthInfoKHR>(projectionCopy->views[0].next);
+  ASSERT_NE(depthInfoCopy, nullptr);
+  EXPECT_NE(depthInfoCopy, &depthInfo);
+  EXPECT_EQ(depthInfoCopy->nearZ, 0.1f);
+
+  EXPECT_EQ(copy->layers[1]->type, xr::StructureType::CompositionLayerQuad);
+  EXPECT_NE(copy->layers[1], &quad);
+
+  // The copy stands alone: changing the original leaves it be.
+  views[1].subImage.imageArrayIndex = 5;
+  EXPECT_EQ(projectionCopy->views[1].subImage.imageArrayIndex, 1u);
+}
+
+TEST_F(OpenXrCloneTest, exhaustedArenaReturnsNull) {
+  size_t needed;
+  {
+    xr::Arena arena{buffer, sizeof(buffer)};
+    ASSERT_NE(xr::cloneDeep(frameEndInfo, arena), nullptr);
+    needed = arena.used();
+  }
+  xr::Arena small{buffer, needed - 1};
+  EXPECT_EQ(xr::cloneDeep(frameEndInfo, small), nullptr);
+  EXPECT_TRUE(small.exhausted());
+  // What was copied before running out is freed again.
+  EXPECT_EQ(small.used(), 0u);
+
+  small.reset();
+  EXPECT_FALSE(small.exhausted());
+  EXPECT_EQ(small.used(), 0u);
+}
+
+TEST_F(OpenXrCloneTest, unknownStructsFailTheCopy) {
+  XrBaseInStructure unknown{static_cast<XrStructureType>(0x7ffffffe), nullptr};
+  depthInfo.next = &unknown;
+
+  xr::Arena arena{buffer, sizeof(buffer)};
+  EXPECT_EQ(xr::cloneDeep(frameEndInfo, arena), nullptr);
+  EXPECT_EQ(xr::cloneChain(&projection, arena), nullptr);
+  EXPECT_FALSE(arena.exhausted());
+  EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST_F(OpenXrCloneTest, arenaRewindsToAMark) {
+  xr::Arena arena{buffer, sizeof(buffer)};
+  ASSERT_NE(arena.allocate(16, 8), nullptr);
+  const size_t mark = arena.used();
+  ASSERT_NE(xr::cloneDeep(frameEndInfo, arena), nullptr);
+  EXPECT_GT(arena.used(), mark);
+  arena.rewind(mark);
+  EXPECT_EQ(arena.used(), mark);
+  arena.rewind(arena.used() + 1);
+  EXPECT_EQ(arena.used(), mark);
+}
+
+TEST_F(OpenXrCloneTest, stringsAreCopied) {
+  const char *names[] = {"XR_APILAYER_first", "XR_APILAYER_second"};
+  xr::InstanceCreateInfo createInfo;
+  createInfo.enabledApiLayerCount = 2;
+  createInfo.enabledApiLayerNames = names;
+
+  xr::Arena arena{buffer, sizeof(buffer)};
+  auto *copy = static_cast<const xr::InstanceCreateInfo *>(xr::cloneChain(&createInfo, arena));
+  ASSERT_NE(copy, nullptr);
+  EXPECT_NE(copy->enabledApiLayerNames, names);
+  EXPECT_NE(copy->enabledApiLayerNames[1], names[1]);
+  EXPECT_STREQ(copy->enabledApiLayerNames[1], "XR_APILAYER_second");
+  EXPECT_EQ(xr::cloneChain(nullptr, arena), nullptr);
+}
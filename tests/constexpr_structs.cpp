@@ -0,0 +1,42 @@
+#include "openxr/openxr.hpp"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+// Structs without fixed-size arrays can be constant-initialized as of C++11.
+static constexpr xr::ReferenceSpaceCreateInfo stageSpace{
+    xr::ReferenceSpaceType::Stage, xr::Posef{xr::Quaternionf{}, xr::Vector3f{0.f, 1.5f, 0.f}}};
+static_assert(stageSpace.type == xr::StructureType::ReferenceSpaceCreateInfo, "type is set");
+static_assert(stageSpace.poseInReferenceSpace.orientation.w == 1.f, "default Quaternionf is the identity");
+static_assert(stageSpace.poseInReferenceSpace.position.y == 1.5f, "members are initialized");
+
+static constexpr xr::CompositionLayerQuad quadTemplate{};
+static_assert(!quadTemplate.layerFlags, "flags start empty");
+
+static constexpr xr::CompositionLayerFlags layerFlags =
+    xr::CompositionLayerFlagBits::BlendTextureSourceAlpha | xr::CompositionLayerFlagBits::CorrectChromaticAberration;
+static_assert(layerFlags & xr::CompositionLayerFlagBits::BlendTextureSourceAlpha, "flags combine at compile time");
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+// Those with fixed-size strings or arrays need C++14.
+static constexpr xr::ActionCreateInfo grabAction{"grab", xr::ActionType::BooleanInput, 0, nullptr, "Grab object"};
+static_assert(grabAction.actionName[3] == 'b' && grabAction.actionName[4] == '\0', "string is copied");
+static_assert(grabAction.localizedActionName[0] == 'G', "string is copied");
+#endif
+
+class OpenXrConstexprStructsTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(OpenXrConstexprStructsTest, longStringsAreTruncated) {
+  char longName[XR_MAX_ACTION_NAME_SIZE + 16];
+  memset(longName, 'a', sizeof(longName) - 1);
+  longName[sizeof(longName) - 1] = '\0';
+  xr::ActionCreateInfo createInfo{longName, xr::ActionType::BooleanInput, 0, nullptr, nullptr};
+  EXPECT_EQ(strlen(createInfo.actionName), XR_MAX_ACTION_NAME_SIZE - 1u);
+  EXPECT_EQ(createInfo.localizedActionName[0], '\0');
+}
@@ -0,0 +1,257 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_coroutine.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+
+// A coroutine that starts eagerly and whose frame is freed when it finishes.
+struct Task {
+  struct promise_type {
+    Task get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+// Queues jobs until run() runs them on the calling thread.
+struct QueueExecutor {
+  std::deque<std::function<void()>> *jobs;
+
+  void operator()(std::function<void()> job) const { jobs->push_back(std::move(job)); }
+
+  size_t run() const {
+    size_t count = 0;
+    while (!jobs->empty()) {
+      auto job = std::move(jobs->front());
+      jobs->pop_front();
+      job();
+      ++count;
+    }
+    return count;
+  }
+};
+
+// Runs each job at once, then counts it: touching itself after a job that may have freed the awaitable.
+struct InlineExecutor {
+  size_t *count;
+
+  void operator()(std::function<void()> job) const {
+    job();
+    ++*count;
+  }
+};
+
+struct StubRuntime {
+  int64_t displayTime = 1000000000;
+  uint32_t waitFrameCount = 0;
+  XrResult waitFrameResult = XR_SUCCESS;
+  uint32_t nextImage = 0;
+  XrDuration lastTimeout = 0;
+  XrResult waitImageResult = XR_SUCCESS;
+  std::deque<XrEventDataBuffer> events;
+
+  void pushStateChange(XrSessionState state) {
+    XrEventDataBuffer buffer{};
+    auto &event = reinterpret_cast<XrEventDataSessionStateChanged &>(buffer);
+    event.type = XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED;
+    event.state = state;
+    events.push_back(buffer);
+  }
+
+  void pushInstanceLossPending() {
+    XrEventDataBuffer buffer{};
+    buffer.type = XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING;
+    events.push_back(buffer);
+  }
+};
+
+struct StubDispatch {
+  StubRuntime *runtime;
+
+  XrResult xrWaitFrame(XrSession, const XrFrameWaitInfo *, XrFrameState *frameState) const noexcept {
+    ++runtime->waitFrameCount;
+    if (runtime->waitFrameResult != XR_SUCCESS) {
+      return runtime->waitFrameResult;
+    }
+    runtime->displayTime += 11111111;
+    frameState->predictedDisplayTime = runtime->displayTime;
+    return XR_SUCCESS;
+  }
+
+  XrResult xrAcquireSwapchainImage(XrSwapchain, const XrSwapchainImageAcquireInfo *, uint32_t *index) const noexcept {
+    *index = runtime->nextImage;
+    runtime->nextImage = (runtime->nextImage + 1) % 3;
+    return XR_SUCCESS;
+  }
+
+  XrResult xrWaitSwapchainImage(XrSwapchain, const XrSwapchainImageWaitInfo *waitInfo) const noexcept {
+    runtime->lastTimeout = waitInfo->timeout;
+    return runtime->waitImageResult;
+  }
+
+  XrResult xrPollEvent(XrInstance, XrEventDataBuffer *buffer) const noexcept {
+    if (runtime->events.empty()) {
+      return XR_EVENT_UNAVAILABLE;
+    }
+    memcpy(buffer, &runtime->events.front(), sizeof(XrEventDataBuffer));
+    runtime->events.pop_front();
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(StubDispatch)
+
+class OpenXrCoroutineTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  StubRuntime runtime;
+  StubDispatch dispatch{&runtime};
+  std::deque<std::function<void()>> jobs;
+  QueueExecutor executor{&jobs};
+};
+
+TEST_F(OpenXrCoroutineTest, nextFrameWaitsOnTheExecutor) {
+  std::vector<int64_t> displayTimes;
+  auto frames = [&]() -> Task {
+    for (int i = 0; i < 3; ++i) {
+      auto frameState = co_await xr::nextFrame(xr::Session{}, executor, dispatch);
+#ifdef OPENXR_HPP_NO_EXCEPTIONS
+      displayTimes.push_back(frameState.value.predictedDisplayTime.get());
+#else
+      displayTimes.push_back(frameState.predictedDisplayTime.get());
+#endif
+    }
+  };
+  frames();
+
+  // Suspended until the executor runs the job calling xrWaitFrame.
+  EXPECT_EQ(runtime.waitFrameCount, 0u);
+  EXPECT_EQ(jobs.size(), 1u);
+  EXPECT_EQ(executor.run(), 3u);
+  EXPECT_EQ(runtime.waitFrameCount, 3u);
+  ASSERT_EQ(displayTimes.size(), 3u);
+  EXPECT_EQ(displayTimes[0], 1011111111);
+  EXPECT_EQ(displayTimes[2] - displayTimes[1], 11111111);
+}
+
+TEST_F(OpenXrCoroutineTest, nextFrameReportsErrors) {
+  runtime.waitFrameResult = XR_ERROR_SESSION_NOT_RUNNING;
+  xr::Result result = xr::Result::Success;
+  auto frame = [&]() -> Task {
+#ifdef OPENXR_HPP_NO_EXCEPTIONS
+    result = (co_await xr::nextFrame(xr::Session{}, executor, dispatch)).result;
+#else
+    try {
+      co_await xr::nextFrame(xr::Session{}, executor, dispatch);
+    } catch (xr::exceptions::SystemError const &e) {
+      result = static_cast<xr::Result>(e.code().value());
+    }
+#endif
+  };
+  frame();
+  executor.run();
+  EXPECT_EQ(result, xr::Result::ErrorSessionNotRunning);
+}
+
+TEST_F(OpenXrCoroutineTest, executorMayOutliveTheCoroutine) {
+  size_t count = 0;
+  InlineExecutor inlineExecutor{&count};
+  bool done = false;
+  auto frame = [&]() -> Task {
+    co_await xr::nextFrame(xr::Session{}, inlineExecutor, dispatch);
+    done = true;
+  };
+  frame();
+
+  // The coroutine finished, and its frame was freed, within the executor.
+  EXPECT_TRUE(done);
+  EXPECT_EQ(count, 1u);
+}
+
+TEST_F(OpenXrCoroutineTest, acquireImageWaitsForTheImage) {
+  std::vector<uint32_t> images;
+  auto render = [&]() -> Task {
+    for (int i = 0; i < 4; ++i) {
+      auto acquired = co_await xr::acquireImage(xr::Swapchain{}, executor, xr::Duration::infinite(), dispatch);
+      EXPECT_EQ(acquired.result, xr::Result::Success);
+      images.push_back(acquired.value);
+    }
+  };
+  render();
+  executor.run();
+  EXPECT_EQ(images, (std::vector<uint32_t>{0, 1, 2, 0}));
+  EXPECT_EQ(runtime.lastTimeout, XR_INFINITE_DURATION);
+}
+
+TEST_F(OpenXrCoroutineTest, acquireImageReportsTimeouts) {
+  runtime.waitImageResult = XR_TIMEOUT_EXPIRED;
+  xr::Result result = xr::Result::Success;
+  auto render = [&]() -> Task {
+    result = (co_await xr::acquireImage(xr::Swapchain{}, executor, xr::Duration{1000000}, dispatch)).result;
+  };
+  render();
+  executor.run();
+  EXPECT_EQ(result, xr::Result::TimeoutExpired);
+  EXPECT_EQ(runtime.lastTimeout, 1000000);
+}
+
+TEST_F(OpenXrCoroutineTest, eventsResumeEveryAwaitingCoroutine) {
+  xr::AwaitableEventPump<QueueExecutor> events{xr::Instance{}, executor};
+  std::vector<xr::SessionState> states;
+  auto watch = [&]() -> Task {
+    auto changed = co_await events.next<xr::EventDataSessionStateChanged>();
+    states.push_back(changed.state);
+  };
+  watch();
+  watch();
+
+  runtime.pushInstanceLossPending();
+  runtime.pushStateChange(XR_SESSION_STATE_READY);
+  EXPECT_EQ(events.drain(dispatch), 2u);
+
+  // Resumed on the executor, not in drain().
+  EXPECT_TRUE(states.empty());
+  EXPECT_EQ(executor.run(), 2u);
+  EXPECT_EQ(states, (std::vector<xr::SessionState>{xr::SessionState::Ready, xr::SessionState::Ready}));
+}
+
+TEST_F(OpenXrCoroutineTest, eventsAreKeptUntilAwaited) {
+  xr::AwaitableEventPump<QueueExecutor> events{xr::Instance{}, executor, 2};
+  runtime.pushStateChange(XR_SESSION_STATE_IDLE);
+  runtime.pushStateChange(XR_SESSION_STATE_READY);
+  runtime.pushStateChange(XR_SESSION_STATE_SYNCHRONIZED);
+  EXPECT_EQ(events.drain(dispatch), 3u);
+  EXPECT_EQ(events.dropped(), 1u);
+
+  std::vector<xr::SessionState> states;
+  auto watch = [&]() -> Task {
+    for (int i = 0; i < 3; ++i) {
+      auto changed = co_await events.next<xr::EventDataSessionStateChanged>();
+      states.push_back(changed.state);
+    }
+  };
+  watch();
+
+  // The kept events are taken without suspending: the next is awaited.
+  EXPECT_TRUE(jobs.empty());
+  EXPECT_EQ(states, (std::vector<xr::SessionState>{xr::SessionState::Ready, xr::SessionState::Synchronized}));
+
+  runtime.pushStateChange(XR_SESSION_STATE_IDLE);
+  events.drain(dispatch);
+  executor.run();
+  EXPECT_EQ(states.back(), xr::SessionState::Idle);
+}
+
+#endif  // defined(__cpp_impl_coroutine)
@@ -8,5 +8,18 @@
 static void bla() {
   xr::Instance inst;
   xr::DispatchLoaderDynamic d;
-  inst.getVulkanDeviceExtensionsKHR(xr::SystemId{}, d);
+  static_cast<void>(inst.getVulkanDeviceExtensionsKHR(xr::SystemId{}, d));
 }
+
+// Without exceptions, only allocating wrappers may throw.
+static_assert(noexcept(std::declval<xr::Instance&>().pollEvent(std::declval<xr::EventDataBuffer&>(),
+                                                                 std::declval<xr::DispatchLoaderDynamic&>())),
+              "enhanced wrapper should be noexcept without exceptions");
+static_assert(noexcept(std::declval<xr::Instance&>().createSession(std::declval<xr::SessionCreateInfo const&>(),
+                                                                     std::declval<xr::DispatchLoaderDynamic&>())),
+              "enhanced wrapper should be noexcept without exceptions");
+static_assert(noexcept(std::declval<xr::Session&>().beginFrame(std::declval<xr::FrameBeginInfo const&>())),
+              "enhanced wrapper should be noexcept without exceptions");
+static_assert(!noexcept(std::declval<xr::Instance&>().getVulkanDeviceExtensionsKHR(
+                  xr::SystemId{}, std::declval<xr::DispatchLoaderDynamic&>())),
+              "two-call wrapper allocates");
@@ -3,3 +3,8 @@
 #include "xr_dependencies.h"
 
 static xr::DispatchLoaderDynamic xr_dispatch{};
+
+static_assert(noexcept(xr_dispatch.xrPollEvent(XR_NULL_HANDLE, nullptr)), "dispatch should be noexcept");
+static_assert(!noexcept(std::declval<xr::Instance&>().pollEvent(std::declval<xr::EventDataBuffer&>(),
+                                                                  std::declval<xr::DispatchLoaderDynamic&>())),
+              "enhanced wrapper may throw");
@@ -0,0 +1,126 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_event_bus.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime: hands out a fixed number of events, alternating between a known and an unknown type.
+struct FakeEventDispatch {
+  std::atomic<uint32_t> *remaining;
+
+  XrResult xrPollEvent(XrInstance, XrEventDataBuffer *eventData) const noexcept {
+    if (*remaining == 0) {
+      return XR_EVENT_UNAVAILABLE;
+    }
+    uint32_t i = --*remaining;
+    if (i % 2 == 0) {
+      auto *event = reinterpret_cast<XrEventDataSessionStateChanged *>(eventData);
+      event->type = XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED;
+      event->time = static_cast<XrTime>(i);
+    } else {
+      eventData->type = static_cast<XrStructureType>(0x7ffffff0);
+    }
+    return XR_SUCCESS;
+  }
+};
+
+class OpenXrEventBusTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  std::atomic<uint32_t> remaining{0};
+  FakeEventDispatch dispatch{&remaining};
+};
+
+TEST_F(OpenXrEventBusTest, subscribersOnlyGetTheirTypes) {
+  remaining = 6;
+  xr::EventBus bus{xr::Instance{}};
+  xr::EventSubscription &sessions = bus.subscribe(xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>());
+  xr::EventSubscription &unknown = bus.subscribe(xr::EventTypeMask{}.add<xr::EventDataBaseHeader>());
+  xr::EventSubscription &all = bus.subscribe(xr::EventTypeMask::all());
+  EXPECT_EQ(bus.drain(dispatch), 6u);
+
+  uint32_t sessionCount = 0;
+  EXPECT_EQ(sessions.consume([&](xr::EventDataSessionStateChanged const &) { ++sessionCount; }), 3u);
+  EXPECT_EQ(sessionCount, 3u);
+
+  xr::EventDataBuffer event;
+  uint32_t unknownCount = 0;
+  while (unknown.tryPop(event)) {
+    EXPECT_FALSE(xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>().contains(event.type));
+    ++unknownCount;
+  }
+  EXPECT_EQ(unknownCount, 3u);
+  EXPECT_EQ(all.consume([](xr::EventDataBaseHeader const &) {}), 6u);
+}
+
+TEST_F(OpenXrEventBusTest, fullQueueDrops) {
+  remaining = 10;
+  xr::EventBus bus{xr::Instance{}};
+  xr::EventSubscription &all = bus.subscribe(xr::EventTypeMask::all(), 4);
+  EXPECT_EQ(bus.drain(dispatch), 10u);
+  EXPECT_EQ(all.dropped(), 6u);
+  EXPECT_EQ(all.consume([](xr::EventDataBaseHeader const &) {}), 4u);
+}
+
+TEST_F(OpenXrEventBusTest, consumerThreadSeesEventsInOrder) {
+  const uint32_t total = 10000;
+  remaining = total;
+  xr::EventBus bus{xr::Instance{}};
+  xr::EventSubscription &sessions = bus.subscribe(xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>(), 16);
+
+  std::atomic<bool> done{false};
+  uint32_t received = 0;
+  bool inOrder = true;
+  std::thread consumer([&] {
+    XrTime last = total;
+    auto visitor = [&](xr::EventDataSessionStateChanged const &event) {
+      inOrder = inOrder && event.time.get() < last;
+      last = event.time.get();
+      ++received;
+    };
+    while (!done) {
+      sessions.consume(visitor);
+    }
+    sessions.consume(visitor);
+  });
+  while (remaining > 0) {
+    bus.pump(xr::EventPumpBudget{8}, dispatch);
+  }
+  done = true;
+  consumer.join();
+
+  EXPECT_TRUE(inOrder);
+  EXPECT_EQ(received + sessions.dropped(), total / 2);
+}
+
+TEST_F(OpenXrEventBusTest, waitPopSleepsUntilAnEventOfItsTypes) {
+  xr::EventBus bus{xr::Instance{}};
+  xr::EventSubscription &sessions =
+      bus.subscribe(xr::EventTypeMask{}.add<xr::EventDataSessionStateChanged>(), 1024);
+
+  xr::EventDataBuffer event;
+  EXPECT_FALSE(sessions.waitPop(event, std::chrono::milliseconds(1)));
+
+  const uint32_t total = 1000;
+  uint32_t received = 0;
+  std::thread consumer([&] {
+    xr::EventDataBuffer e;
+    while (received < total / 2 && sessions.waitPop(e, std::chrono::seconds(10))) {
+      EXPECT_EQ(e.type, xr::StructureType::EventDataSessionStateChanged);
+      ++received;
+    }
+  });
+  for (uint32_t i = 0; i < total; ++i) {
+    remaining = 1 + (i % 2);
+    bus.pump(xr::EventPumpBudget{1}, dispatch);
+  }
+  consumer.join();
+  EXPECT_EQ(received, total / 2);
+  EXPECT_EQ(sessions.dropped(), 0u);
+}
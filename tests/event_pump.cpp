@@ -0,0 +1,96 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_event_pump.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime: hands out a fixed number of events, alternating between a known and an unknown type.
+struct FakeEventDispatch {
+  uint32_t *remaining;
+  uint32_t *polls;
+
+  XrResult xrPollEvent(XrInstance, XrEventDataBuffer *eventData) const noexcept {
+    ++*polls;
+    EXPECT_EQ(eventData->type, XR_TYPE_EVENT_DATA_BUFFER);
+    EXPECT_EQ(eventData->next, nullptr);
+    if (*remaining == 0) {
+      return XR_EVENT_UNAVAILABLE;
+    }
+    --*remaining;
+    if (*remaining % 2 == 0) {
+      auto *event = reinterpret_cast<XrEventDataSessionStateChanged *>(eventData);
+      event->type = XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED;
+      event->state = XR_SESSION_STATE_READY;
+    } else {
+      eventData->type = static_cast<XrStructureType>(0x7ffffff0);
+    }
+    return XR_SUCCESS;
+  }
+};
+
+struct CountingVisitor {
+  uint32_t sessionStateChanged = 0;
+  uint32_t other = 0;
+
+  void operator()(xr::EventDataSessionStateChanged const &event) {
+    EXPECT_EQ(event.state, xr::SessionState::Ready);
+    ++sessionStateChanged;
+  }
+  void operator()(xr::EventDataBaseHeader const &) { ++other; }
+};
+
+class OpenXrEventPumpTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  uint32_t remaining = 0;
+  uint32_t polls = 0;
+  FakeEventDispatch dispatch{&remaining, &polls};
+};
+
+TEST_F(OpenXrEventPumpTest, drainsAllPending) {
+  remaining = 5;
+  xr::EventPump pump{xr::Instance{}};
+  CountingVisitor visitor;
+  EXPECT_EQ(pump.drain(visitor, dispatch), 5u);
+  EXPECT_EQ(visitor.sessionStateChanged, 3u);
+  EXPECT_EQ(visitor.other, 2u);
+  EXPECT_EQ(polls, 6u);
+  EXPECT_EQ(pump.lastResult(), xr::Result::EventUnavailable);
+}
+
+TEST_F(OpenXrEventPumpTest, countBudget) {
+  remaining = 5;
+  xr::EventPump pump{xr::Instance{}};
+  CountingVisitor visitor;
+  EXPECT_EQ(pump.pump(visitor, xr::EventPumpBudget{2}, dispatch), 2u);
+  EXPECT_EQ(remaining, 3u);
+  EXPECT_EQ(pump.pump(visitor, xr::EventPumpBudget{10}, dispatch), 3u);
+  EXPECT_EQ(remaining, 0u);
+}
+
+TEST_F(OpenXrEventPumpTest, timeBudgetHandlesAtLeastOne) {
+  remaining = 5;
+  xr::EventPump pump{xr::Instance{}};
+  CountingVisitor visitor;
+  EXPECT_EQ(pump.pump(visitor, xr::EventPumpBudget{std::chrono::nanoseconds(1)}, dispatch), 1u);
+}
+
+TEST_F(OpenXrEventPumpTest, unhandledTypesIgnored) {
+  remaining = 4;
+  xr::EventPump pump{xr::Instance{}};
+  uint32_t count = 0;
+  EXPECT_EQ(pump.drain([&](xr::EventDataSessionStateChanged const &) { ++count; }, dispatch), 4u);
+  EXPECT_EQ(count, 2u);
+}
+
+TEST_F(OpenXrEventPumpTest, visitEventReportsUnknownTypes) {
+  xr::EventDataBuffer buffer;
+  CountingVisitor visitor;
+  EXPECT_FALSE(xr::visitEvent(buffer, visitor));
+  EXPECT_EQ(visitor.other, 1u);
+}
@@ -0,0 +1,115 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_extrapolation.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class OpenXrExtrapolationTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+namespace {
+constexpr float kTolerance = 1e-4f;
+const xr::SpaceLocationFlags kLocated =
+    xr::SpaceLocationFlagBits::OrientationValid | xr::SpaceLocationFlagBits::PositionValid;
+const xr::SpaceVelocityFlags kMoving = xr::SpaceVelocityFlagBits::LinearValid | xr::SpaceVelocityFlagBits::AngularValid;
+
+xr::Time seconds(double s) { return xr::Time{static_cast<XrTime>(s * 1e9)}; }
+
+void expectNear(xr::Posef const& a, xr::Posef const& b) {
+  EXPECT_NEAR(a.orientation.x, b.orientation.x, kTolerance);
+  EXPECT_NEAR(a.orientation.y, b.orientation.y, kTolerance);
+  EXPECT_NEAR(a.orientation.z, b.orientation.z, kTolerance);
+  EXPECT_NEAR(a.orientation.w, b.orientation.w, kTolerance);
+  EXPECT_NEAR(a.position.x, b.position.x, kTolerance);
+  EXPECT_NEAR(a.position.y, b.position.y, kTolerance);
+  EXPECT_NEAR(a.position.z, b.position.z, kTolerance);
+}
+}  // namespace
+
+TEST_F(OpenXrExtrapolationTest, constantVelocity) {
+  xr::SpaceLocation location;
+  location.locationFlags = kLocated;
+  location.pose = xr::Posef{xr::Quaternionf{}, {1.f, 2.f, 3.f}};
+  xr::SpaceVelocity velocity;
+  velocity.velocityFlags = kMoving;
+  velocity.linearVelocity = xr::Vector3f{0.f, 0.f, -2.f};
+  // A quarter turn per second about +Y.
+  velocity.angularVelocity = xr::Vector3f{0.f, 1.57079633f, 0.f};
+
+  const xr::Posef predicted = xr::math::extrapolate(location, velocity, seconds(10.0), seconds(10.5));
+  expectNear(predicted, xr::Posef{{0.f, 0.38268343f, 0.f, 0.92387953f}, {1.f, 2.f, 2.f}});
+
+  // Backwards works too.
+  const xr::Posef earlier = xr::math::extrapolate(location, velocity, seconds(10.0), seconds(9.0));
+  expectNear(earlier, xr::Posef{{0.f, -0.70710678f, 0.f, 0.70710678f}, {1.f, 2.f, 5.f}});
+}
+
+TEST_F(OpenXrExtrapolationTest, honorsValidity) {
+  xr::SpaceVelocity velocity;
+  velocity.velocityFlags = xr::SpaceVelocityFlagBits::LinearValid;
+  velocity.linearVelocity = xr::Vector3f{1.f, 0.f, 0.f};
+  velocity.angularVelocity = xr::Vector3f{0.f, 5.f, 0.f};
+  xr::SpaceLocation location;
+  location.locationFlags = kLocated;
+  // Found through the next chain.
+  location.next = &velocity;
+
+  xr::math::PoseExtrapolator<4> extrapolator;
+  ASSERT_TRUE(extrapolator.update(2, location, seconds(1.0)));
+  EXPECT_EQ(extrapolator.size(), 3u);
+  EXPECT_FALSE(extrapolator.update(4, location, seconds(1.0)));
+
+  // The angular velocity is not valid, so the orientation stays put.
+  expectNear(extrapolator.predict(2, seconds(1.1)), xr::Posef{xr::Quaternionf{}, {0.1f, 0.f, 0.f}});
+
+  // Without a position, neither does the position.
+  location.locationFlags = xr::SpaceLocationFlagBits::OrientationValid;
+  location.pose.position = xr::Vector3f{5.f, 5.f, 5.f};
+  ASSERT_TRUE(extrapolator.update(2, location, seconds(2.0)));
+  expectNear(extrapolator.predict(2, seconds(3.0)), xr::Posef{xr::Quaternionf{}, {0.f, 0.f, 0.f}});
+  EXPECT_EQ(extrapolator.locationFlags(2), xr::SpaceLocationFlags{xr::SpaceLocationFlagBits::OrientationValid});
+}
+
+TEST_F(OpenXrExtrapolationTest, constantAcceleration) {
+  xr::SpaceVelocity velocity;
+  velocity.velocityFlags = kMoving;
+  xr::SpaceLocation location;
+  location.locationFlags = kLocated;
+  location.next = &velocity;
+
+  xr::math::PoseExtrapolator<1> extrapolator;
+  velocity.linearVelocity = xr::Vector3f{1.f, 0.f, 0.f};
+  extrapolator.update(0, location, seconds(1.0));
+  velocity.linearVelocity = xr::Vector3f{2.f, 0.f, 0.f};
+  extrapolator.update(0, location, seconds(2.0));
+
+  EXPECT_NEAR(extrapolator.predict(0, seconds(3.0)).position.x, 2.f, kTolerance);
+  EXPECT_NEAR(extrapolator.predict(0, seconds(3.0), xr::math::MotionModel::ConstantAcceleration).position.x, 2.5f,
+              kTolerance);
+}
+
+TEST_F(OpenXrExtrapolationTest, batchMatchesSingle) {
+  xr::math::PoseExtrapolator<10> extrapolator;
+  for (size_t i = 0; i < 10; ++i) {
+    const float f = static_cast<float>(i);
+    xr::SpaceVelocity velocity;
+    velocity.velocityFlags = i == 3 ? xr::SpaceVelocityFlags{} : kMoving;
+    velocity.linearVelocity = xr::Vector3f{f, -f, 0.5f};
+    velocity.angularVelocity = xr::Vector3f{0.3f * f, 1.f, -0.2f * f};
+    xr::SpaceLocation location;
+    location.locationFlags = kLocated;
+    location.pose = xr::Posef{xr::math::normalize({0.1f * f, 0.2f, 0.3f, 1.f}), {f, 1.f, -f}};
+    extrapolator.update(i, location, &velocity, seconds(1.0 + 0.001 * i));
+  }
+
+  std::vector<xr::Posef> poses(12);
+  ASSERT_EQ(extrapolator.predict(seconds(1.02), poses), 10u);
+  for (size_t i = 0; i < 10; ++i) {
+    expectNear(poses[i], extrapolator.predict(i, seconds(1.02)));
+  }
+}
@@ -0,0 +1,161 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_frame_loop.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+constexpr int64_t kPeriod = 11111111;
+}  // namespace
+
+// Stands in for a runtime, with a virtual clock: each xrWaitFrame blocks until the frame before is begun, then
+// returns the next display period, without sleeping.
+struct StubRuntime {
+  std::mutex mutex;
+  std::condition_variable begun;
+  int64_t displayTime = 1000000000;
+  uint64_t waitCount = 0;
+  uint64_t beginCount = 0;
+  uint64_t endCount = 0;
+  uint64_t waitLimit = UINT64_MAX;
+  bool sessionRunning = true;
+
+  void endSession() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      sessionRunning = false;
+    }
+    begun.notify_all();
+  }
+};
+
+struct StubFrameDispatch {
+  StubRuntime *runtime;
+
+  XrResult xrWaitFrame(XrSession, const XrFrameWaitInfo *, XrFrameState *frameState) const noexcept {
+    std::unique_lock<std::mutex> lock(runtime->mutex);
+    runtime->begun.wait(lock,
+                        [this] { return runtime->beginCount == runtime->waitCount || !runtime->sessionRunning; });
+    if (!runtime->sessionRunning || runtime->waitCount == runtime->waitLimit) {
+      return XR_ERROR_SESSION_NOT_RUNNING;
+    }
+    ++runtime->waitCount;
+    runtime->displayTime += kPeriod;
+    frameState->predictedDisplayTime = runtime->displayTime;
+    frameState->predictedDisplayPeriod = kPeriod;
+    frameState->shouldRender = XR_TRUE;
+    return XR_SUCCESS;
+  }
+
+  XrResult xrBeginFrame(XrSession, const XrFrameBeginInfo *) const noexcept {
+    {
+      std::lock_guard<std::mutex> lock(runtime->mutex);
+      if (runtime->beginCount == runtime->waitCount) {
+        return XR_ERROR_CALL_ORDER_INVALID;
+      }
+      ++runtime->beginCount;
+    }
+    runtime->begun.notify_all();
+    return XR_SUCCESS;
+  }
+
+  XrResult xrEndFrame(XrSession, const XrFrameEndInfo *) const noexcept {
+    std::lock_guard<std::mutex> lock(runtime->mutex);
+    ++runtime->endCount;
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(StubFrameDispatch)
+
+class OpenXrFrameLoopTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  StubRuntime runtime;
+  StubFrameDispatch dispatch{&runtime};
+};
+
+TEST_F(OpenXrFrameLoopTest, framesArriveInOrder) {
+  xr::FrameLoop<StubFrameDispatch> loop{xr::Session{}, dispatch};
+  loop.start();
+  std::vector<int64_t> displayTimes;
+  xr::FrameState frameState;
+  while (displayTimes.size() < 100 && loop.acquire(frameState)) {
+    ASSERT_EQ(loop.beginFrame(), xr::Result::Success);
+    displayTimes.push_back(frameState.predictedDisplayTime.get());
+    ASSERT_EQ(loop.endFrame(xr::FrameEndInfo{}), xr::Result::Success);
+  }
+  runtime.endSession();
+  loop.stop();
+
+  ASSERT_EQ(displayTimes.size(), 100u);
+  for (size_t i = 1; i < displayTimes.size(); ++i) {
+    EXPECT_EQ(displayTimes[i] - displayTimes[i - 1], kPeriod);
+  }
+  EXPECT_EQ(runtime.beginCount, 100u);
+  EXPECT_EQ(runtime.endCount, 100u);
+  EXPECT_EQ(loop.framesSkipped(), 0u);
+}
+
+TEST_F(OpenXrFrameLoopTest, nextFrameIsWaitedForWhileRendering) {
+  xr::FrameLoop<StubFrameDispatch> loop{xr::Session{}, dispatch};
+  loop.start();
+  xr::FrameState frameState;
+  ASSERT_TRUE(loop.acquire(frameState));
+  const xr::Time first = frameState.predictedDisplayTime;
+  ASSERT_EQ(loop.beginFrame(), xr::Result::Success);
+
+  // Frame 1 is begun but not ended: the pacing thread already has frame 2.
+  xr::FrameState next;
+  ASSERT_TRUE(loop.acquire(next));
+  EXPECT_EQ(next.predictedDisplayTime, first + xr::Duration{kPeriod});
+  EXPECT_EQ(runtime.endCount, 0u);
+  EXPECT_FALSE(loop.tryAcquire(next));
+
+  loop.endFrame(xr::FrameEndInfo{});
+  loop.beginFrame();
+  loop.endFrame(xr::FrameEndInfo{});
+  runtime.endSession();
+  loop.stop();
+  EXPECT_EQ(runtime.endCount, 2u);
+}
+
+TEST_F(OpenXrFrameLoopTest, failuresStopThePacingThread) {
+  runtime.waitLimit = 3;
+  xr::FrameLoop<StubFrameDispatch> loop{xr::Session{}, dispatch};
+  loop.start();
+  xr::FrameState frameState;
+  int frames = 0;
+  while (loop.acquire(frameState)) {
+    loop.beginFrame();
+    loop.endFrame(xr::FrameEndInfo{});
+    ++frames;
+  }
+  EXPECT_EQ(frames, 3);
+  EXPECT_EQ(loop.lastResult(), xr::Result::ErrorSessionNotRunning);
+  EXPECT_EQ(loop.framesWaited(), 3u);
+}
+
+TEST_F(OpenXrFrameLoopTest, stopWakesTheRenderThread) {
+  xr::FrameLoop<StubFrameDispatch> loop{xr::Session{}, dispatch};
+  xr::FrameState frameState;
+  EXPECT_FALSE(loop.tryAcquire(frameState));
+  loop.start();
+  ASSERT_TRUE(loop.acquire(frameState));
+
+  // Frame 1 is never begun, so frame 2 never comes, until the session ends.
+  std::thread stopper([&] {
+    runtime.endSession();
+    loop.stop();
+  });
+  EXPECT_FALSE(loop.acquire(frameState));
+  stopper.join();
+  EXPECT_EQ(runtime.beginCount, 0u);
+}
@@ -0,0 +1,116 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_frame_timing.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+namespace {
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+constexpr int64_t kPeriod = 11111111;  // 90 Hz
+
+xr::FrameState frameState(int64_t displayTime, int64_t period = kPeriod) {
+  xr::FrameState state;
+  state.predictedDisplayTime = xr::Time{displayTime};
+  state.predictedDisplayPeriod = xr::Duration{period};
+  state.shouldRender = true;
+  return state;
+}
+}  // namespace
+
+class OpenXrFrameTimingTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  using Clock = std::chrono::steady_clock;
+
+  // Runs one frame displayed at @p displayTime, spending @p waitToBegin and @p beginToEnd in each phase.
+  template <typename Recorder>
+  void frame(Recorder &recorder, int64_t displayTime, microseconds waitToBegin, microseconds beginToEnd,
+             int64_t period = kPeriod) {
+    recorder.frameWaited(frameState(displayTime, period), now);
+    now += waitToBegin;
+    recorder.frameBegun(now);
+    now += beginToEnd;
+    recorder.frameEnded(now);
+    now += milliseconds(1);
+  }
+
+  Clock::time_point now{};
+};
+
+TEST_F(OpenXrFrameTimingTest, histogramBuckets) {
+  EXPECT_EQ(xr::LatencyHistogram::bucket(microseconds(0)), 0u);
+  EXPECT_EQ(xr::LatencyHistogram::bucket(microseconds(7)), 7u);
+  EXPECT_EQ(xr::LatencyHistogram::bucket(microseconds(-5)), 0u);
+  EXPECT_EQ(xr::LatencyHistogram::bucket(std::chrono::hours(1)), xr::LatencyHistogram::bucketCount - 1);
+  // The last bucket starts at about 29 s and covers up to about 33.5 s.
+  EXPECT_EQ(xr::LatencyHistogram::lowerBound(xr::LatencyHistogram::bucketCount - 1).count(), int64_t(7) << 22);
+  EXPECT_EQ(xr::LatencyHistogram::bucket(microseconds((int64_t(7) << 22) - 1)), xr::LatencyHistogram::bucketCount - 2);
+  EXPECT_EQ(xr::LatencyHistogram::bucket(microseconds((int64_t(1) << 25) - 1)), xr::LatencyHistogram::bucketCount - 1);
+  for (int64_t us : {8, 10, 15, 16, 1000, 11111, 65535, 1000000}) {
+    const size_t bucket = xr::LatencyHistogram::bucket(microseconds(us));
+    EXPECT_LE(xr::LatencyHistogram::lowerBound(bucket).count(), us);
+    EXPECT_GT(xr::LatencyHistogram::lowerBound(bucket + 1).count(), us);
+    EXPECT_LE(xr::LatencyHistogram::lowerBound(bucket + 1).count(), us + us / 4 + 1);
+  }
+}
+
+TEST_F(OpenXrFrameTimingTest, missedAndDuplicatedFrames) {
+  xr::FrameTimingRecorder<> recorder;
+  int64_t displayTime = 1000000000;
+  frame(recorder, displayTime, microseconds(100), microseconds(5000));
+  frame(recorder, displayTime += kPeriod + 300000, microseconds(100), microseconds(5000));
+  EXPECT_EQ(recorder.current().missedFrames, 0u);
+
+  // Two periods skipped, with some jitter.
+  frame(recorder, displayTime += 3 * kPeriod - 200000, microseconds(100), microseconds(5000));
+  EXPECT_EQ(recorder.current().missedFrames, 2u);
+
+  frame(recorder, displayTime, microseconds(100), microseconds(5000));
+  EXPECT_EQ(recorder.current().duplicatedFrames, 1u);
+
+  // 120 Hz.
+  frame(recorder, displayTime += 8333333, microseconds(100), microseconds(5000), 8333333);
+  xr::FrameTimingSnapshot const &current = recorder.current();
+  EXPECT_EQ(current.frameCount, 5u);
+  EXPECT_EQ(current.missedFrames, 2u);
+  EXPECT_EQ(current.periodChanges, 1u);
+  EXPECT_EQ(current.predictedDisplayPeriod, xr::Duration{8333333});
+  EXPECT_EQ(current.predictedDisplayTime, xr::Time{displayTime});
+}
+
+TEST_F(OpenXrFrameTimingTest, histogramsCoverTheWindow) {
+  xr::FrameTimingRecorder<10> recorder;
+  for (int i = 0; i < 10; ++i) {
+    frame(recorder, 1000000000 + i * kPeriod, microseconds(200), milliseconds(8));
+  }
+  xr::FrameTimingSnapshot const &current = recorder.current();
+  EXPECT_EQ(current.waitToBegin.total, 10u);
+  EXPECT_EQ(current.waitToBegin.counts[xr::LatencyHistogram::bucket(microseconds(200))], 10u);
+  EXPECT_GE(current.beginToEnd.percentile(0.5), milliseconds(8));
+  EXPECT_LE(current.beginToEnd.percentile(0.5), milliseconds(10));
+
+  // The slow frames push the fast ones out of the window.
+  for (int i = 10; i < 20; ++i) {
+    frame(recorder, 1000000000 + i * kPeriod, microseconds(200), milliseconds(20));
+  }
+  EXPECT_EQ(current.beginToEnd.total, 10u);
+  EXPECT_EQ(current.beginToEnd.counts[xr::LatencyHistogram::bucket(milliseconds(8))], 0u);
+  EXPECT_GE(current.beginToEnd.percentile(0.99), milliseconds(20));
+}
+
+TEST_F(OpenXrFrameTimingTest, snapshotsArePublishedAtFrameEnd) {
+  xr::FrameTimingRecorder<> recorder;
+  EXPECT_EQ(recorder.snapshot().frameCount, 0u);
+  frame(recorder, 1000000000, microseconds(100), microseconds(5000));
+  recorder.frameWaited(frameState(1000000000 + kPeriod), now);
+  EXPECT_EQ(recorder.current().frameCount, 2u);
+  xr::FrameTimingSnapshot const &snapshot = recorder.snapshot();
+  EXPECT_EQ(snapshot.frameCount, 1u);
+  EXPECT_EQ(snapshot.beginToEnd.total, 1u);
+}
@@ -0,0 +1,76 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_structure_chain.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+class OpenXrHashTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(OpenXrHashTest, handlesAndAtomsKeyMaps) {
+  std::unordered_map<xr::Path, int> paths{{xr::Path{1}, 1}, {xr::Path{2}, 2}};
+  EXPECT_EQ(paths.at(xr::Path{2}), 2);
+
+  std::unordered_set<xr::Space> spaces{xr::Space{}, xr::Space{}};
+  EXPECT_EQ(spaces.size(), 1u);
+
+  std::unordered_set<xr::Time> times{xr::Time{1}, xr::Time{2}, xr::Time{1}};
+  EXPECT_EQ(times.size(), 2u);
+
+  std::unordered_set<xr::SwapchainUsageFlags> usages{xr::SwapchainUsageFlagBits::ColorAttachment,
+                                                     xr::SwapchainUsageFlagBits::Sampled};
+  EXPECT_EQ(usages.size(), 2u);
+}
+
+TEST_F(OpenXrHashTest, structsCompareMemberWise) {
+  xr::ReferenceSpaceCreateInfo stage{xr::ReferenceSpaceType::Stage, xr::Posef{}};
+  xr::ReferenceSpaceCreateInfo view{xr::ReferenceSpaceType::View, xr::Posef{}};
+  EXPECT_EQ(stage, stage);
+  EXPECT_NE(stage, view);
+
+  xr::ReferenceSpaceCreateInfo raised = stage;
+  raised.poseInReferenceSpace.position.y = 1.f;
+  EXPECT_NE(stage, raised);
+
+  std::unordered_map<xr::ReferenceSpaceCreateInfo, int> cache{{stage, 1}, {view, 2}, {raised, 3}};
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.at(xr::ReferenceSpaceCreateInfo{xr::ReferenceSpaceType::View, xr::Posef{}}), 2);
+}
+
+TEST_F(OpenXrHashTest, stringsCompareUpToTerminator) {
+  xr::ActionCreateInfo a{"grab", xr::ActionType::BooleanInput, 0, nullptr, "Grab"};
+  xr::ActionCreateInfo b = a;
+  b.actionName[10] = 'x';
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(std::hash<xr::ActionCreateInfo>{}(a), std::hash<xr::ActionCreateInfo>{}(b));
+  b.actionName[0] = 'G';
+  EXPECT_NE(a, b);
+}
+
+TEST_F(OpenXrHashTest, nextIsIgnoredUnlessChained) {
+  xr::CompositionLayerDepthInfoKHR depth1;
+  xr::CompositionLayerDepthInfoKHR depth2;
+  depth2.nearZ = 0.5f;
+  xr::CompositionLayerProjectionView view1;
+  xr::CompositionLayerProjectionView view2;
+  view1.next = &depth1;
+  view2.next = &depth2;
+  EXPECT_EQ(view1, view2);
+  EXPECT_EQ(std::hash<xr::CompositionLayerProjectionView>{}(view1),
+            std::hash<xr::CompositionLayerProjectionView>{}(view2));
+
+  EXPECT_FALSE(xr::equalChains(view1.next, view2.next));
+  xr::ChainedEqualTo<xr::CompositionLayerProjectionView> equal;
+  EXPECT_FALSE(equal(view1, view2));
+
+  depth2.nearZ = depth1.nearZ;
+  EXPECT_TRUE(equal(view1, view2));
+  xr::ChainedHash<xr::CompositionLayerProjectionView> hash;
+  EXPECT_EQ(hash(view1), hash(view2));
+}
@@ -0,0 +1,117 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_joints.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+class OpenXrJointsTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+namespace {
+constexpr float kTolerance = 1e-5f;
+const xr::SpaceLocationFlags kValid =
+    xr::SpaceLocationFlagBits::OrientationValid | xr::SpaceLocationFlagBits::PositionValid;
+
+std::array<xr::HandJointLocationEXT, 26> makeHand() {
+  std::array<xr::HandJointLocationEXT, 26> hand;
+  for (size_t i = 0; i < hand.size(); ++i) {
+    const float f = static_cast<float>(i);
+    hand[i].locationFlags = kValid;
+    hand[i].pose = xr::Posef{xr::math::scalar::normalize({0.1f * f, 0.2f, -0.05f * f, 1.f}), {0.01f * f, 0.02f * f, -0.3f}};
+    hand[i].radius = 0.01f;
+  }
+  return hand;
+}
+
+void expectNear(xr::Posef const& a, xr::Posef const& b) {
+  EXPECT_NEAR(a.orientation.x, b.orientation.x, kTolerance);
+  EXPECT_NEAR(a.orientation.y, b.orientation.y, kTolerance);
+  EXPECT_NEAR(a.orientation.z, b.orientation.z, kTolerance);
+  EXPECT_NEAR(a.orientation.w, b.orientation.w, kTolerance);
+  EXPECT_NEAR(a.position.x, b.position.x, kTolerance);
+  EXPECT_NEAR(a.position.y, b.position.y, kTolerance);
+  EXPECT_NEAR(a.position.z, b.position.z, kTolerance);
+}
+}  // namespace
+
+TEST_F(OpenXrJointsTest, loadAndStore) {
+  std::array<xr::HandJointLocationEXT, 26> hand = makeHand();
+  hand[3].locationFlags = xr::SpaceLocationFlagBits::OrientationValid;
+
+  xr::math::JointBatch<26> joints;
+  ASSERT_TRUE(xr::math::loadJoints(xr::Span<const xr::HandJointLocationEXT>(hand), joints));
+  EXPECT_EQ(joints.count, 26u);
+  EXPECT_TRUE(joints.isValid(0));
+  EXPECT_FALSE(joints.isValid(3));
+  expectNear(joints.pose(5), hand[5].pose);
+
+  xr::math::JointBatch<8> small;
+  EXPECT_FALSE(xr::math::loadJoints(xr::Span<xr::HandJointLocationEXT>(hand), small));
+  EXPECT_EQ(small.count, 0u);
+}
+
+TEST_F(OpenXrJointsTest, transformMatchesCompose) {
+  std::array<xr::HandJointLocationEXT, 26> hand = makeHand();
+  hand[7].locationFlags = xr::SpaceLocationFlagBits::PositionValid;
+  const std::array<xr::HandJointLocationEXT, 26> original = hand;
+  const xr::Posef stageInWorld{xr::math::scalar::normalize({0.f, 0.6f, 0.f, 0.8f}), {2.f, 0.f, -1.f}};
+
+  xr::math::JointBatch<26> joints;
+  ASSERT_TRUE(xr::math::loadJoints(xr::Span<xr::HandJointLocationEXT>(hand), joints));
+  xr::math::transformJoints(stageInWorld, joints);
+  xr::math::storeJoints(joints, xr::Span<xr::HandJointLocationEXT>(hand));
+
+  for (size_t i = 0; i < hand.size(); ++i) {
+    if (i == 7) {
+      // Invalid joints are left alone.
+      expectNear(hand[i].pose, original[i].pose);
+    } else {
+      expectNear(hand[i].pose, xr::math::scalar::compose(stageInWorld, original[i].pose));
+    }
+  }
+
+  xr::math::JointBatch<26> scalarJoints;
+  ASSERT_TRUE(xr::math::loadJoints(xr::Span<const xr::HandJointLocationEXT>(original), scalarJoints));
+  xr::math::scalar::transformJoints(stageInWorld, scalarJoints);
+  for (size_t i = 0; i < hand.size(); ++i) {
+    expectNear(scalarJoints.pose(i), hand[i].pose);
+  }
+}
+
+TEST_F(OpenXrJointsTest, bones) {
+  std::array<xr::HandJointLocationEXT, 26> hand = makeHand();
+  hand[11].locationFlags = xr::SpaceLocationFlags{};
+
+  xr::math::JointBatch<26> joints;
+  ASSERT_TRUE(xr::math::loadJoints(xr::Span<const xr::HandJointLocationEXT>(hand), joints));
+  xr::math::BoneBatch<26> bones;
+  ASSERT_TRUE(xr::math::computeBones(joints, xr::math::handJointParents(), bones));
+  EXPECT_EQ(bones.count, 26u);
+
+  // Index proximal, from its metacarpal.
+  EXPECT_NE(bones.valid[7], 0u);
+  EXPECT_NEAR(bones.x[7], hand[7].pose.position.x - hand[6].pose.position.x, kTolerance);
+  EXPECT_NEAR(bones.y[7], hand[7].pose.position.y - hand[6].pose.position.y, kTolerance);
+  EXPECT_NEAR(bones.length[7], std::sqrt(bones.x[7] * bones.x[7] + bones.y[7] * bones.y[7] + bones.z[7] * bones.z[7]),
+              kTolerance);
+  // The wrist is the root.
+  EXPECT_EQ(bones.length[1], 0.f);
+  // Both ends of a bone must be valid.
+  EXPECT_EQ(bones.valid[11], 0u);
+  EXPECT_EQ(bones.valid[12], 0u);
+  EXPECT_EQ(bones.length[12], 0.f);
+
+  xr::math::BoneBatch<26> scalarBones;
+  ASSERT_TRUE(xr::math::scalar::computeBones(joints, xr::math::handJointParents(), scalarBones));
+  for (size_t i = 0; i < 26; ++i) {
+    EXPECT_NEAR(scalarBones.length[i], bones.length[i], kTolerance);
+  }
+
+  const uint32_t tooFew[] = {0, 0};
+  EXPECT_FALSE(xr::math::computeBones(joints, tooFew, bones));
+}
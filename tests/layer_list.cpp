@@ -0,0 +1,121 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_layer_list.hpp"
+#include "openxr/openxr_structure_chain.hpp"
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime: records what xrEndFrame was given.
+struct FakeEndFrameDispatch {
+  uint32_t *layerCount;
+  const XrCompositionLayerBaseHeader *const **layers;
+
+  XrResult xrEndFrame(XrSession, const XrFrameEndInfo *frameEndInfo) const noexcept {
+    *layerCount = frameEndInfo->layerCount;
+    *layers = frameEndInfo->layers;
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(FakeEndFrameDispatch)
+
+class OpenXrLayerListTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    views[0].subImage.imageArrayIndex = 0;
+    views[1].subImage.imageArrayIndex = 1;
+  }
+
+  void TearDown() override {}
+
+  xr::CompositionLayerProjectionView views[2];
+  uint32_t layerCount = 0;
+  const XrCompositionLayerBaseHeader *const *layers = nullptr;
+  FakeEndFrameDispatch dispatch{&layerCount, &layers};
+};
+
+TEST_F(OpenXrLayerListTest, layersAreStoredInline) {
+  xr::LayerList<> list;
+  xr::CompositionLayerProjection *projection = list.addProjection(xr::CompositionLayerProjection{}, views);
+  ASSERT_NE(projection, nullptr);
+  EXPECT_EQ(projection->viewCount, 2u);
+  EXPECT_NE(projection->views, views);
+  EXPECT_EQ(projection->views[1].subImage.imageArrayIndex, 1u);
+
+  xr::CompositionLayerQuad *quad = list.add(xr::CompositionLayerQuad{});
+  ASSERT_NE(quad, nullptr);
+  ASSERT_EQ(list.size(), 2u);
+  EXPECT_EQ(list.layers()[0], projection);
+  EXPECT_EQ(list.layers()[1], quad);
+}
+
+TEST_F(OpenXrLayerListTest, layersAreReusedAcrossFrames) {
+  xr::LayerList<> list;
+  xr::CompositionLayerProjection *projection = list.addProjection(xr::CompositionLayerProjection{}, views);
+  xr::CompositionLayerQuad *quad = list.add(xr::CompositionLayerQuad{});
+  for (uint32_t frame = 0; frame < 3; ++frame) {
+    for (xr::CompositionLayerProjectionView &view : list.projectionViews(projection)) {
+      view.subImage.imageArrayIndex = frame;
+    }
+    quad->pose.position.z = -static_cast<float>(frame);
+    xr::endFrame(xr::Session{}, xr::FrameEndInfo{}, list, dispatch);
+
+    ASSERT_EQ(layerCount, 2u);
+    auto *submitted = reinterpret_cast<const XrCompositionLayerProjection *>(layers[0]);
+    EXPECT_EQ(submitted->views[1].subImage.imageArrayIndex, frame);
+    EXPECT_EQ(reinterpret_cast<const XrCompositionLayerQuad *>(layers[1])->pose.position.z, -static_cast<float>(frame));
+  }
+}
+
+TEST_F(OpenXrLayerListTest, chainedStructsAreCopied) {
+  xr::LayerList<> list;
+  xr::CompositionLayerProjection *projection;
+  {
+    xr::CompositionLayerDepthInfoKHR depthInfo;
+    depthInfo.nearZ = 0.1f;
+    views[0].next = &depthInfo;
+    projection = list.addProjection(xr::CompositionLayerProjection{}, views);
+    views[0].next = nullptr;
+  }
+  ASSERT_NE(projection, nullptr);
+  auto *depthInfoCopy = xr::findInChain<xr::CompositionLayerDepthInfoKHR>(projection->views[0].next);
+  ASSERT_NE(depthInfoCopy, nullptr);
+  EXPECT_EQ(depthInfoCopy->nearZ, 0.1f);
+}
+
+TEST_F(OpenXrLayerListTest, fullListRejectsLayers) {
+  xr::LayerList<1> list;
+  EXPECT_NE(list.add(xr::CompositionLayerQuad{}), nullptr);
+  EXPECT_EQ(list.add(xr::CompositionLayerQuad{}), nullptr);
+  EXPECT_EQ(list.addProjection(xr::CompositionLayerProjection{}, views), nullptr);
+
+  xr::LayerList<4, sizeof(xr::CompositionLayerQuad)> small;
+  EXPECT_NE(small.add(xr::CompositionLayerQuad{}), nullptr);
+  EXPECT_EQ(small.add(xr::CompositionLayerQuad{}), nullptr);
+
+  small.clear();
+  EXPECT_TRUE(small.empty());
+  EXPECT_NE(small.add(xr::CompositionLayerQuad{}), nullptr);
+}
+
+TEST_F(OpenXrLayerListTest, layersThatDoNotFitLeaveNoTrace) {
+  // Room for a projection layer and one view, but not two.
+  xr::LayerList<4, sizeof(xr::CompositionLayerProjection) + sizeof(xr::CompositionLayerProjectionView)> list;
+  EXPECT_EQ(list.addProjection(xr::CompositionLayerProjection{}, views), nullptr);
+  EXPECT_TRUE(list.empty());
+
+  xr::CompositionLayerProjection *projection = list.addProjection(xr::CompositionLayerProjection{}, {views, 1});
+  ASSERT_NE(projection, nullptr);
+  EXPECT_EQ(projection->viewCount, 1u);
+  EXPECT_EQ(list.size(), 1u);
+}
+
+TEST_F(OpenXrLayerListTest, unknownChainedStructsAreRejected) {
+  XrBaseInStructure unknown{static_cast<XrStructureType>(0x7ffffffe), nullptr};
+  xr::CompositionLayerQuad quad;
+  quad.next = &unknown;
+
+  xr::LayerList<> list;
+  EXPECT_EQ(list.add(quad), nullptr);
+  EXPECT_TRUE(list.empty());
+  quad.next = nullptr;
+  EXPECT_NE(list.add(quad), nullptr);
+}
@@ -1,7 +1,12 @@
 #include "openxr/openxr.hpp"
+#include "openxr/openxr_math.hpp"
 
 #include <gtest/gtest.h>
 
+#if defined(OPENXR_HPP_TEST_SIMD) && !defined(OPENXR_HPP_MATH_SSE4)
+#error "The SIMD build of the tests does not use the SSE4.1 paths of xr::math"
+#endif
+
 class OpenXrMathTest : public ::testing::Test {
 protected:
   void SetUp() override {}
@@ -21,3 +26,82 @@ TEST_F(OpenXrMathTest, vecTest) {
     EXPECT_EQ(xr::Vector3f().y, 0.f);
     EXPECT_EQ(xr::Vector3f().z, 0.f);
 }
+
+namespace {
+constexpr float kTolerance = 1e-5f;
+// 90 degrees about +Z
+const xr::Quaternionf kQuarterTurnZ{0.f, 0.f, 0.70710678f, 0.70710678f};
+
+void expectNear(xr::Vector3f const& a, xr::Vector3f const& b) {
+    EXPECT_NEAR(a.x, b.x, kTolerance);
+    EXPECT_NEAR(a.y, b.y, kTolerance);
+    EXPECT_NEAR(a.z, b.z, kTolerance);
+}
+
+void expectNear(xr::Quaternionf const& a, xr::Quaternionf const& b) {
+    EXPECT_NEAR(a.x, b.x, kTolerance);
+    EXPECT_NEAR(a.y, b.y, kTolerance);
+    EXPECT_NEAR(a.z, b.z, kTolerance);
+    EXPECT_NEAR(a.w, b.w, kTolerance);
+}
+
+void expectNear(xr::Posef const& a, xr::Posef const& b) {
+    expectNear(a.orientation, b.orientation);
+    expectNear(a.position, b.position);
+}
+}  // namespace
+
+TEST_F(OpenXrMathTest, rotateAndTransform) {
+    expectNear(xr::math::rotate(kQuarterTurnZ, {1.f, 0.f, 0.f}), {0.f, 1.f, 0.f});
+    expectNear(xr::math::rotate(xr::Quaternionf{}, {1.f, 2.f, 3.f}), {1.f, 2.f, 3.f});
+
+    xr::Posef pose{kQuarterTurnZ, {1.f, 2.f, 3.f}};
+    expectNear(xr::math::transformPoint(pose, {1.f, 0.f, 0.f}), {1.f, 3.f, 3.f});
+    expectNear(xr::math::transformVector(pose, {1.f, 0.f, 0.f}), {0.f, 1.f, 0.f});
+}
+
+TEST_F(OpenXrMathTest, composeAndInvert) {
+    xr::Posef a{kQuarterTurnZ, {1.f, 2.f, 3.f}};
+    xr::Posef b{xr::math::normalize({0.1f, 0.2f, 0.3f, 0.9f}), {-1.f, 0.5f, 4.f}};
+
+    expectNear(xr::math::compose(a, xr::math::invert(a)), xr::Posef{});
+    expectNear(xr::math::compose(xr::math::invert(a), a), xr::Posef{});
+
+    // Composing then transforming matches transforming twice.
+    xr::Vector3f point{0.25f, -2.f, 1.f};
+    expectNear(xr::math::transformPoint(xr::math::compose(a, b), point),
+               xr::math::transformPoint(a, xr::math::transformPoint(b, point)));
+}
+
+TEST_F(OpenXrMathTest, slerp) {
+    expectNear(xr::math::slerp(xr::Quaternionf{}, kQuarterTurnZ, 0.f), xr::Quaternionf{});
+    expectNear(xr::math::slerp(xr::Quaternionf{}, kQuarterTurnZ, 1.f), kQuarterTurnZ);
+    // Halfway is 45 degrees about +Z.
+    expectNear(xr::math::slerp(xr::Quaternionf{}, kQuarterTurnZ, 0.5f), {0.f, 0.f, 0.38268343f, 0.92387953f});
+
+    // q and -q are the same rotation; take the short way around.
+    xr::Quaternionf negated{-kQuarterTurnZ.x, -kQuarterTurnZ.y, -kQuarterTurnZ.z, -kQuarterTurnZ.w};
+    expectNear(xr::math::rotate(xr::math::slerp(xr::Quaternionf{}, negated, 0.5f), {1.f, 0.f, 0.f}),
+               {0.70710678f, 0.70710678f, 0.f});
+}
+
+TEST_F(OpenXrMathTest, matchesScalar) {
+    xr::Posef a{xr::math::scalar::normalize({0.3f, -0.4f, 0.1f, 0.8f}), {1.f, 2.f, 3.f}};
+    xr::Posef b{xr::math::scalar::normalize({-0.2f, 0.7f, 0.5f, 0.1f}), {-3.f, 0.5f, 2.f}};
+    xr::Vector3f v{0.5f, -1.5f, 2.5f};
+
+    expectNear(xr::math::multiply(a.orientation, b.orientation),
+               xr::math::scalar::multiply(a.orientation, b.orientation));
+    expectNear(xr::math::rotate(a.orientation, v), xr::math::scalar::rotate(a.orientation, v));
+    expectNear(xr::math::compose(a, b), xr::math::scalar::compose(a, b));
+    expectNear(xr::math::invert(a), xr::math::scalar::invert(a));
+    expectNear(xr::math::transformPoint(a, v), xr::math::scalar::transformPoint(a, v));
+    expectNear(xr::math::slerp(a.orientation, b.orientation, 0.3f),
+               xr::math::scalar::slerp(a.orientation, b.orientation, 0.3f));
+    EXPECT_NEAR(xr::math::dot(a.orientation, b.orientation), xr::math::scalar::dot(a.orientation, b.orientation),
+                kTolerance);
+#if defined(OPENXR_HPP_MATH_SSE4) || defined(OPENXR_HPP_MATH_NEON)
+    expectNear(xr::math::simd::rotate(a.orientation, v), xr::math::scalar::rotate(a.orientation, v));
+    expectNear(xr::math::simd::transformPoint(a, v), xr::math::scalar::transformPoint(a, v));
+#endif
+}
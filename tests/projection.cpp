@@ -0,0 +1,110 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_projection.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+// Projections from tangents are constexpr in C++14.
+static constexpr xr::math::Matrix4x4f symmetricProjection =
+    xr::math::projection(xr::math::FovTangents{-1.f, 1.f, 1.f, -1.f}, 0.1f, 100.f);
+static_assert(symmetricProjection.m[0] == 1.f && symmetricProjection.m[11] == -1.f, "built at compile time");
+#endif
+
+class OpenXrProjectionTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+namespace {
+constexpr float kTolerance = 1e-4f;
+const xr::math::FovTangents kTangents{-1.f, 1.f, 0.5f, -0.75f};
+
+// The normalized device coordinates of view-space point (x, y, z).
+xr::Vector3f project(xr::math::Matrix4x4f const& m, float x, float y, float z) {
+  const float w = m.m[3] * x + m.m[7] * y + m.m[11] * z + m.m[15];
+  return {(m.m[0] * x + m.m[4] * y + m.m[8] * z + m.m[12]) / w, (m.m[1] * x + m.m[5] * y + m.m[9] * z + m.m[13]) / w,
+          (m.m[2] * x + m.m[6] * y + m.m[10] * z + m.m[14]) / w};
+}
+}  // namespace
+
+TEST_F(OpenXrProjectionTest, clipSpaces) {
+  using xr::math::ClipSpace;
+  using xr::math::DepthDirection;
+
+  xr::math::Matrix4x4f gl = xr::math::projection(kTangents, 0.5f, 50.f, ClipSpace::OpenGL);
+  EXPECT_NEAR(project(gl, 0.f, 0.f, -0.5f).z, -1.f, kTolerance);
+  EXPECT_NEAR(project(gl, 0.f, 0.f, -50.f).z, 1.f, kTolerance);
+  // The edges of the field of view map to the edges of the screen.
+  EXPECT_NEAR(project(gl, -1.f, 0.f, -1.f).x, -1.f, kTolerance);
+  EXPECT_NEAR(project(gl, 0.f, 0.5f, -1.f).y, 1.f, kTolerance);
+  EXPECT_NEAR(project(gl, 0.f, -0.75f, -1.f).y, -1.f, kTolerance);
+
+  xr::math::Matrix4x4f d3d = xr::math::projection(kTangents, 0.5f, 50.f, ClipSpace::Direct3D);
+  EXPECT_NEAR(project(d3d, 0.f, 0.f, -0.5f).z, 0.f, kTolerance);
+  EXPECT_NEAR(project(d3d, 0.f, 0.f, -50.f).z, 1.f, kTolerance);
+
+  xr::math::Matrix4x4f vulkan = xr::math::projection(kTangents, 0.5f, 50.f, ClipSpace::Vulkan);
+  EXPECT_NEAR(project(vulkan, 0.f, 0.5f, -1.f).y, -1.f, kTolerance);
+  EXPECT_NEAR(project(vulkan, 0.f, 0.f, -50.f).z, 1.f, kTolerance);
+
+  xr::math::Matrix4x4f reversed =
+      xr::math::projection(kTangents, 0.5f, 50.f, ClipSpace::Direct3D, DepthDirection::Reversed);
+  EXPECT_NEAR(project(reversed, 0.f, 0.f, -0.5f).z, 1.f, kTolerance);
+  EXPECT_NEAR(project(reversed, 0.f, 0.f, -50.f).z, 0.f, kTolerance);
+
+  xr::math::Matrix4x4f reversedGl =
+      xr::math::projection(kTangents, 0.5f, 50.f, ClipSpace::OpenGL, DepthDirection::Reversed);
+  EXPECT_NEAR(project(reversedGl, 0.f, 0.f, -0.5f).z, 1.f, kTolerance);
+  EXPECT_NEAR(project(reversedGl, 0.f, 0.f, -50.f).z, -1.f, kTolerance);
+
+  // An infinite far plane.
+  xr::math::Matrix4x4f infinite =
+      xr::math::projection(kTangents, 0.5f, 0.f, ClipSpace::Vulkan, DepthDirection::Reversed);
+  EXPECT_NEAR(project(infinite, 0.f, 0.f, -0.5f).z, 1.f, kTolerance);
+  EXPECT_NEAR(project(infinite, 0.f, 0.f, -1e6f).z, 0.f, kTolerance);
+}
+
+TEST_F(OpenXrProjectionTest, viewMatrixInvertsPose) {
+  const xr::Posef pose{xr::math::normalize({0.1f, 0.7f, -0.2f, 0.6f}), {1.f, 1.6f, -2.f}};
+  const xr::math::Matrix4x4f identity =
+      xr::math::multiply(xr::math::viewMatrix(pose), xr::math::matrix(pose));
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_NEAR(identity.m[i], i % 5 == 0 ? 1.f : 0.f, kTolerance);
+  }
+
+  const xr::math::Matrix4x4f a = xr::math::matrix(pose);
+  const xr::math::Matrix4x4f b = xr::math::projection(kTangents, 0.1f, 10.f);
+  const xr::math::Matrix4x4f simd = xr::math::multiply(a, b);
+  const xr::math::Matrix4x4f scalar = xr::math::scalar::multiply(a, b);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_NEAR(simd.m[i], scalar.m[i], kTolerance);
+  }
+}
+
+TEST_F(OpenXrProjectionTest, computeViewMatrices) {
+  std::vector<xr::View> views(2);
+  views[0].pose = xr::Posef{xr::Quaternionf{}, {-0.03f, 1.6f, 0.f}};
+  views[1].pose = xr::Posef{xr::Quaternionf{}, {0.03f, 1.6f, 0.f}};
+  views[0].fov = views[1].fov = xr::Fovf{-0.785398f, 0.785398f, 0.785398f, -0.785398f};
+
+  xr::math::ViewMatrices matrices[4];
+  ASSERT_EQ(xr::math::computeViewMatrices(views, 0.1f, 100.f, matrices), 2u);
+
+  // A point straight ahead of the left eye lands in the middle of its screen.
+  const xr::Vector3f center = project(matrices[0].viewProjection, -0.03f, 1.6f, -5.f);
+  EXPECT_NEAR(center.x, 0.f, kTolerance);
+  EXPECT_NEAR(center.y, 0.f, kTolerance);
+
+  const xr::math::Frustum& frustum = matrices[0].frustum;
+  EXPECT_TRUE(frustum.intersectsSphere({-0.03f, 1.6f, -5.f}, 0.1f));
+  // Behind, beyond the far plane, and off to the side.
+  EXPECT_FALSE(frustum.intersectsSphere({-0.03f, 1.6f, 5.f}, 0.1f));
+  EXPECT_FALSE(frustum.intersectsSphere({-0.03f, 1.6f, -200.f}, 0.1f));
+  EXPECT_FALSE(frustum.intersectsSphere({10.f, 1.6f, -5.f}, 0.1f));
+  // Spheres straddling an edge count.
+  EXPECT_TRUE(frustum.intersectsSphere({4.97f + 0.5f, 1.6f, -5.f}, 1.f));
+}
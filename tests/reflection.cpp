@@ -0,0 +1,88 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_reflection.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using FrameEndInfoFields = xr::StructDescriptor<xr::FrameEndInfo>;
+static_assert(FrameEndInfoFields::field_count == 6, "all members are described, type and next included");
+static_assert(FrameEndInfoFields::fields[2].offset == offsetof(XrFrameEndInfo, displayTime), "offsets are known");
+static_assert(FrameEndInfoFields::fields[5].isPointer && FrameEndInfoFields::fields[5].pointerDepth == 2,
+              "layers is an array of pointers");
+static_assert(xr::StructDescriptor<XrActionCreateInfo>::fields[2].arrayLength == XR_MAX_ACTION_NAME_SIZE,
+              "original types are described too");
+
+// A binary serializer for the values of a struct: pointers are skipped.
+struct ValueWriter {
+  std::vector<unsigned char> &out;
+
+  template <typename T>
+  void operator()(xr::FieldDescriptor const &field, T const &value) {
+    if (!field.isPointer) {
+      const size_t offset = out.size();
+      out.resize(offset + sizeof(value));
+      memcpy(out.data() + offset, &value, sizeof(value));
+    }
+  }
+};
+
+struct ValueReader {
+  const unsigned char *in;
+
+  template <typename T>
+  void operator()(xr::FieldDescriptor const &field, T &value) {
+    if (!field.isPointer) {
+      memcpy(&value, in, sizeof(value));
+      in += sizeof(value);
+    }
+  }
+};
+
+struct NameCollector {
+  std::vector<const char *> &names;
+
+  template <typename T>
+  void operator()(xr::FieldDescriptor const &field, T const &) {
+    names.push_back(field.name);
+  }
+};
+
+class OpenXrReflectionTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(OpenXrReflectionTest, fieldsAreDescribed) {
+  EXPECT_STREQ(FrameEndInfoFields::name, "XrFrameEndInfo");
+  EXPECT_STREQ(FrameEndInfoFields::fields[5].name, "layers");
+  EXPECT_STREQ(FrameEndInfoFields::fields[5].type, "XrCompositionLayerBaseHeader");
+  EXPECT_STREQ(FrameEndInfoFields::fields[5].countField, "layerCount");
+  EXPECT_EQ(FrameEndInfoFields::fields[4].countField, nullptr);
+  EXPECT_EQ(FrameEndInfoFields::fields[4].size, sizeof(uint32_t));
+}
+
+TEST_F(OpenXrReflectionTest, frameEndInfoRoundTrips) {
+  xr::FrameEndInfo frameEndInfo{xr::Time{42}, xr::EnvironmentBlendMode::Additive, 0, nullptr};
+  std::vector<unsigned char> buffer;
+  xr::forEachField(frameEndInfo, ValueWriter{buffer});
+  EXPECT_EQ(buffer.size(), sizeof(XrStructureType) + sizeof(XrTime) + sizeof(XrEnvironmentBlendMode) + sizeof(uint32_t));
+
+  xr::FrameEndInfo copy;
+  xr::forEachField(copy, ValueReader{buffer.data()});
+  EXPECT_EQ(copy.type, xr::StructureType::FrameEndInfo);
+  EXPECT_EQ(copy.displayTime.get(), 42);
+  EXPECT_EQ(copy.environmentBlendMode, xr::EnvironmentBlendMode::Additive);
+}
+
+TEST_F(OpenXrReflectionTest, visitsInOrder) {
+  const xr::ReferenceSpaceCreateInfo createInfo{xr::ReferenceSpaceType::Stage, xr::Posef{}};
+  std::vector<const char *> names;
+  xr::forEachField(createInfo, NameCollector{names});
+  ASSERT_EQ(names.size(), 4u);
+  EXPECT_STREQ(names[2], "referenceSpaceType");
+  EXPECT_STREQ(names[3], "poseInReferenceSpace");
+}
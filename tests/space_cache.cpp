@@ -0,0 +1,156 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_space_cache.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime: a space's x position is its handle value plus the time, and it moves at 1 m/s along x.
+// Space 0 fails to locate.
+struct FakeLocateSpaceDispatch {
+  std::atomic<int> *calls;
+
+  XrResult xrLocateSpace(XrSpace space, XrSpace, XrTime time, XrSpaceLocation *location) const noexcept {
+    ++*calls;
+    if (space == XR_NULL_HANDLE) {
+      return XR_ERROR_HANDLE_INVALID;
+    }
+    location->locationFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT;
+    location->pose.position.x = static_cast<float>(reinterpret_cast<uintptr_t>(space) + time);
+    auto velocity = xr::findInChain<xr::SpaceVelocity>(location->next);
+    if (velocity != nullptr) {
+      velocity->velocityFlags = xr::SpaceVelocityFlagBits::LinearValid;
+      velocity->linearVelocity = xr::Vector3f{1.f, 0.f, 0.f};
+    }
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(FakeLocateSpaceDispatch)
+
+namespace {
+xr::Space makeSpace(uintptr_t id) { return xr::Space{reinterpret_cast<XrSpace>(id)}; }
+}  // namespace
+
+class OpenXrSpaceCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  std::atomic<int> calls{0};
+  FakeLocateSpaceDispatch dispatch{&calls};
+  xr::SpaceLocationCache<> cache;
+  const xr::Space stage = makeSpace(100);
+};
+
+TEST_F(OpenXrSpaceCacheTest, repeatedLocationsAreCached) {
+  xr::SpaceLocation location;
+  for (int i = 0; i < 4; ++i) {
+    location = xr::SpaceLocation{};
+    ASSERT_EQ(cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch), xr::Result::Success);
+    EXPECT_EQ(location.locationFlags, xr::SpaceLocationFlagBits::PositionValid);
+    EXPECT_EQ(location.pose.position.x, 11.f);
+  }
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(cache.hits(), 3u);
+  EXPECT_EQ(cache.misses(), 1u);
+  EXPECT_DOUBLE_EQ(cache.hitRate(), 0.75);
+
+  cache.resetStatistics();
+  EXPECT_EQ(cache.hits(), 0u);
+  EXPECT_EQ(cache.hitRate(), 0.);
+}
+
+TEST_F(OpenXrSpaceCacheTest, keysIncludeBaseSpaceAndTime) {
+  xr::SpaceLocation location;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  cache.locateSpace(makeSpace(2), stage, xr::Time{10}, location, dispatch);
+  cache.locateSpace(makeSpace(1), makeSpace(101), xr::Time{10}, location, dispatch);
+  cache.locateSpace(makeSpace(1), stage, xr::Time{20}, location, dispatch);
+  EXPECT_EQ(location.pose.position.x, 21.f);
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(cache.hits(), 0u);
+}
+
+TEST_F(OpenXrSpaceCacheTest, invalidatedOnNewFrameAndReferenceSpaceChange) {
+  xr::SpaceLocation location;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  cache.beginFrame();
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 2);
+
+  cache(xr::EventDataReferenceSpaceChangePending{});
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 3);
+}
+
+TEST_F(OpenXrSpaceCacheTest, velocitiesAreCachedWhenChained) {
+  xr::SpaceLocation location;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+
+  xr::SpaceVelocity velocity;
+  location.next = &velocity;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(location.next, &velocity);
+  EXPECT_EQ(velocity.velocityFlags, xr::SpaceVelocityFlagBits::LinearValid);
+
+  xr::SpaceVelocity cached;
+  location.next = &cached;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  location.next = nullptr;
+  cache.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(cached.velocityFlags, xr::SpaceVelocityFlagBits::LinearValid);
+  EXPECT_EQ(cached.linearVelocity.x, 1.f);
+}
+
+TEST_F(OpenXrSpaceCacheTest, failuresAreNotCached) {
+  xr::SpaceLocation location;
+  EXPECT_EQ(cache.locateSpace(xr::Space{}, stage, xr::Time{10}, location, dispatch), xr::Result::ErrorHandleInvalid);
+  EXPECT_EQ(cache.locateSpace(xr::Space{}, stage, xr::Time{10}, location, dispatch), xr::Result::ErrorHandleInvalid);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(cache.hits(), 0u);
+}
+
+TEST_F(OpenXrSpaceCacheTest, evictsWhenFull) {
+  xr::SpaceLocationCache<1, 4> small;
+  xr::SpaceLocation location;
+  for (uintptr_t id = 1; id <= 5; ++id) {
+    small.locateSpace(makeSpace(id), stage, xr::Time{10}, location, dispatch);
+  }
+  EXPECT_EQ(calls, 5);
+  small.locateSpace(makeSpace(5), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 5);
+  small.locateSpace(makeSpace(1), stage, xr::Time{10}, location, dispatch);
+  EXPECT_EQ(calls, 6);
+}
+
+TEST_F(OpenXrSpaceCacheTest, threadsShareResults) {
+  constexpr int kThreads = 4;
+  constexpr int kLocations = 1000;
+  std::vector<std::thread> threads;
+  std::atomic<int> wrong{0};
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kLocations; ++i) {
+        const uintptr_t id = 1 + static_cast<uintptr_t>((i + t) % 8);
+        xr::SpaceLocation location;
+        cache.locateSpace(makeSpace(id), stage, xr::Time{10}, location, dispatch);
+        if (location.pose.position.x != static_cast<float>(id + 10)) {
+          ++wrong;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(wrong, 0);
+  EXPECT_EQ(cache.hits() + cache.misses(), static_cast<uint64_t>(kThreads * kLocations));
+  EXPECT_EQ(cache.misses(), static_cast<uint64_t>(calls.load()));
+  EXPECT_GT(cache.hitRate(), 0.9);
+}
@@ -0,0 +1,159 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_space_graph.hpp"
+
+#include <cmath>
+#include <map>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime: locates spaces at fixed poses against any base space, counting calls.
+struct FakeLocateSpaceDispatch {
+  struct Located {
+    xr::Posef pose;
+    xr::SpaceLocationFlags flags;
+  };
+  std::map<XrSpace, Located> *spaces;
+  int *calls;
+
+  XrResult xrLocateSpace(XrSpace space, XrSpace, XrTime, XrSpaceLocation *location) const noexcept {
+    ++*calls;
+    auto it = spaces->find(space);
+    if (it == spaces->end()) {
+      return XR_ERROR_HANDLE_INVALID;
+    }
+    location->pose = *it->second.pose.get();
+    location->locationFlags = static_cast<XrSpaceLocationFlags>(it->second.flags);
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(FakeLocateSpaceDispatch)
+
+namespace {
+constexpr float kTolerance = 1e-5f;
+const xr::SpaceLocationFlags kValid =
+    xr::SpaceLocationFlagBits::OrientationValid | xr::SpaceLocationFlagBits::PositionValid;
+const xr::SpaceLocationFlags kTracked = kValid | xr::SpaceLocationFlagBits::OrientationTracked |
+                                        xr::SpaceLocationFlagBits::PositionTracked;
+
+xr::Space makeSpace(uintptr_t id) { return xr::Space{reinterpret_cast<XrSpace>(id)}; }
+
+void expectNear(xr::Posef const &a, xr::Posef const &b) {
+  EXPECT_NEAR(a.orientation.x, b.orientation.x, kTolerance);
+  EXPECT_NEAR(a.orientation.y, b.orientation.y, kTolerance);
+  EXPECT_NEAR(a.orientation.z, b.orientation.z, kTolerance);
+  EXPECT_NEAR(a.orientation.w, b.orientation.w, kTolerance);
+  EXPECT_NEAR(a.position.x, b.position.x, kTolerance);
+  EXPECT_NEAR(a.position.y, b.position.y, kTolerance);
+  EXPECT_NEAR(a.position.z, b.position.z, kTolerance);
+}
+}  // namespace
+
+class OpenXrSpaceGraphTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  std::map<XrSpace, FakeLocateSpaceDispatch::Located> spaces;
+  int calls = 0;
+  FakeLocateSpaceDispatch dispatch{&spaces, &calls};
+};
+
+TEST_F(OpenXrSpaceGraphTest, spacesAreAddedOnce) {
+  xr::SpaceGraph<2> graph{makeSpace(100)};
+  EXPECT_EQ(graph.add(makeSpace(1)), 0u);
+  EXPECT_EQ(graph.add(makeSpace(2)), 1u);
+  EXPECT_EQ(graph.add(makeSpace(1)), 0u);
+  EXPECT_EQ(graph.add(makeSpace(3)), xr::SpaceGraph<2>::noIndex);
+  EXPECT_EQ(graph.find(makeSpace(2)), 1u);
+  EXPECT_EQ(graph.find(makeSpace(3)), xr::SpaceGraph<2>::noIndex);
+  EXPECT_EQ(graph.size(), 2u);
+  EXPECT_EQ(graph.space(1), makeSpace(2));
+}
+
+TEST_F(OpenXrSpaceGraphTest, eachSpaceIsLocatedOncePerUpdate) {
+  xr::SpaceGraph<> graph{makeSpace(100)};
+  for (uintptr_t id = 1; id <= 10; ++id) {
+    spaces[reinterpret_cast<XrSpace>(id)] = {xr::Posef{{}, {static_cast<float>(id), 0.f, 0.f}}, kTracked};
+    graph.add(makeSpace(id));
+  }
+  EXPECT_EQ(graph.update(xr::Time{1}, dispatch), xr::Result::Success);
+  EXPECT_EQ(calls, 10);
+
+  for (size_t a = 0; a < graph.size(); ++a) {
+    for (size_t b = 0; b < graph.size(); ++b) {
+      xr::SpaceLocation location = graph.locate(a, b);
+      EXPECT_EQ(location.locationFlags, kTracked);
+      EXPECT_NEAR(location.pose.position.x, static_cast<float>(a) - static_cast<float>(b), kTolerance);
+    }
+  }
+  EXPECT_EQ(calls, 10);
+}
+
+TEST_F(OpenXrSpaceGraphTest, locateComposesRelativeToBase) {
+  const float s = std::sqrt(0.5f);
+  // Turned a quarter turn to the left, about +Y.
+  const xr::Posef controller{{0.f, s, 0.f, s}, {1.f, 0.f, 0.f}};
+  const xr::Posef anchor{{}, {1.f, 0.f, -1.f}};
+  spaces[reinterpret_cast<XrSpace>(1)] = {controller, kTracked};
+  spaces[reinterpret_cast<XrSpace>(2)] = {anchor, kValid};
+
+  xr::SpaceGraph<> graph{makeSpace(100)};
+  const size_t c = graph.add(makeSpace(1));
+  const size_t a = graph.add(makeSpace(2));
+  ASSERT_EQ(graph.update(xr::Time{1}, dispatch), xr::Result::Success);
+
+  // One metre forward of the stage is one metre to the right of a controller facing left.
+  xr::SpaceLocation anchorInController = graph.locate(a, c);
+  EXPECT_EQ(anchorInController.locationFlags, kValid);
+  expectNear(anchorInController.pose, xr::Posef{{0.f, -s, 0.f, s}, {1.f, 0.f, 0.f}});
+  expectNear(xr::math::compose(controller, anchorInController.pose), anchor);
+  expectNear(xr::math::compose(graph.locate(c, a).pose, anchorInController.pose), xr::Posef{});
+  expectNear(graph.location(c).pose, controller);
+}
+
+TEST_F(OpenXrSpaceGraphTest, locateAllMatchesLocate) {
+  xr::SpaceGraph<7> graph{makeSpace(100)};
+  for (uintptr_t id = 1; id <= 7; ++id) {
+    const float angle = 0.3f * static_cast<float>(id);
+    const xr::Quaternionf orientation{std::sin(angle) * 0.6f, std::sin(angle) * 0.8f, 0.f, std::cos(angle)};
+    spaces[reinterpret_cast<XrSpace>(id)] = {
+        xr::Posef{orientation, {static_cast<float>(id), -1.f, 0.5f * static_cast<float>(id)}}, kTracked};
+    graph.add(makeSpace(id));
+  }
+  ASSERT_EQ(graph.update(xr::Time{1}, dispatch), xr::Result::Success);
+
+  xr::SpaceLocation locations[7];
+  ASSERT_EQ(graph.locateAll(3, locations), 7u);
+  for (size_t i = 0; i < 7; ++i) {
+    xr::SpaceLocation expected = graph.locate(i, 3);
+    EXPECT_EQ(locations[i].locationFlags, expected.locationFlags);
+    expectNear(locations[i].pose, expected.pose);
+  }
+  expectNear(locations[3].pose, xr::Posef{});
+}
+
+TEST_F(OpenXrSpaceGraphTest, flagsArePropagated) {
+  using Bits = xr::SpaceLocationFlagBits;
+  EXPECT_EQ(xr::relativeLocationFlags(kTracked, kTracked), kTracked);
+  EXPECT_EQ(xr::relativeLocationFlags(kTracked, kValid), kValid);
+  EXPECT_EQ(xr::relativeLocationFlags(kTracked, xr::SpaceLocationFlags{}), xr::SpaceLocationFlags{});
+  // Without the orientation of the space located against, a position can't be rotated into it.
+  EXPECT_EQ(xr::relativeLocationFlags(kTracked, Bits::PositionValid | Bits::PositionTracked),
+            xr::SpaceLocationFlags{});
+  EXPECT_EQ(xr::relativeLocationFlags(kTracked, kValid | Bits::PositionTracked), kValid);
+  EXPECT_EQ(xr::relativeLocationFlags(Bits::PositionValid | Bits::PositionTracked, kTracked),
+            Bits::PositionValid | Bits::PositionTracked);
+}
+
+TEST_F(OpenXrSpaceGraphTest, failedSpacesAreNotValid) {
+  spaces[reinterpret_cast<XrSpace>(1)] = {xr::Posef{{}, {1.f, 2.f, 3.f}}, kTracked};
+  xr::SpaceGraph<> graph{makeSpace(100)};
+  const size_t located = graph.add(makeSpace(1));
+  const size_t lost = graph.add(makeSpace(2));
+  EXPECT_EQ(graph.update(xr::Time{1}, dispatch), xr::Result::ErrorHandleInvalid);
+  EXPECT_EQ(graph.location(located).locationFlags, kTracked);
+  EXPECT_EQ(graph.location(lost).locationFlags, xr::SpaceLocationFlags{});
+  EXPECT_EQ(graph.locate(located, lost).locationFlags, xr::SpaceLocationFlags{});
+  EXPECT_EQ(graph.locate(lost, located).locationFlags, xr::SpaceLocationFlags{});
+}
@@ -0,0 +1,136 @@
+#include "openxr/openxr.hpp"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class OpenXrSpanTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(OpenXrSpanTest, spanViewsInPlace) {
+  std::vector<int> values{1, 2, 3};
+  xr::Span<int> span{values};
+  EXPECT_EQ(span.data(), values.data());
+  EXPECT_EQ(span.size(), 3u);
+  span[1] = 5;
+  EXPECT_EQ(values[1], 5);
+
+  xr::Span<const int> constSpan = span;
+  int sum = 0;
+  for (int value : constSpan) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 9);
+  EXPECT_TRUE(xr::Span<const int>{}.empty());
+}
+
+TEST_F(OpenXrSpanTest, frameEndInfoLayers) {
+  xr::CompositionLayerProjection projection;
+  xr::CompositionLayerQuad quad;
+  std::vector<xr::CompositionLayerBaseHeader *> layers{&projection, &quad};
+
+  xr::FrameEndInfo frameEndInfo;
+  frameEndInfo.setLayers(layers);
+  EXPECT_EQ(frameEndInfo.layerCount, 2u);
+  ASSERT_EQ(frameEndInfo.getLayers().size(), 2u);
+  EXPECT_EQ(frameEndInfo.getLayers()[1]->type, xr::StructureType::CompositionLayerQuad);
+
+  frameEndInfo.setLayers(xr::Span<const xr::CompositionLayerBaseHeader *const>{});
+  EXPECT_EQ(frameEndInfo.layerCount, 0u);
+  EXPECT_TRUE(frameEndInfo.getLayers().empty());
+}
+
+template <typename S, typename = void>
+struct SetterTakesBracedList : std::false_type {};
+template <typename S>
+struct SetterTakesBracedList<
+    S, decltype(void(std::declval<S &>().setActiveActionSets({std::declval<xr::ActiveActionSet>()})))>
+    : std::true_type {};
+
+template <typename S, typename Argument, typename = void>
+struct SetterTakes : std::false_type {};
+template <typename S, typename Argument>
+struct SetterTakes<S, Argument, decltype(void(std::declval<S &>().setActiveActionSets(std::declval<Argument>())))>
+    : std::true_type {};
+
+// The struct would keep pointing at the elements of the list, or of the temporary, once they are destroyed.
+static_assert(!SetterTakesBracedList<xr::ActionsSyncInfo>::value, "struct setters must reject braced lists");
+static_assert(!SetterTakes<xr::ActionsSyncInfo, std::vector<xr::ActiveActionSet>>::value,
+              "struct setters must reject temporary containers");
+static_assert(SetterTakes<xr::ActionsSyncInfo, std::vector<xr::ActiveActionSet> const &>::value,
+              "struct setters take containers that outlive the call");
+
+TEST_F(OpenXrSpanTest, elementsHaveProjectedTypes) {
+  xr::ActiveActionSet activeActionSets[2];
+  xr::ActionsSyncInfo syncInfo;
+  syncInfo.setActiveActionSets(activeActionSets);
+  EXPECT_EQ(syncInfo.countActiveActionSets, 2u);
+  xr::Span<const xr::ActiveActionSet> view = syncInfo.getActiveActionSets();
+  EXPECT_EQ(view.data(), activeActionSets);
+
+  std::array<xr::ActionSuggestedBinding, 3> bindings;
+  xr::InteractionProfileSuggestedBinding suggestedBinding;
+  suggestedBinding.setSuggestedBindings(bindings);
+  EXPECT_EQ(suggestedBinding.countSuggestedBindings, 3u);
+  EXPECT_EQ(suggestedBinding.getSuggestedBindings().data(), bindings.data());
+}
+
+TEST_F(OpenXrSpanTest, outputArraysAreWritable) {
+  std::array<xr::HandJointLocationEXT, XR_HAND_JOINT_COUNT_EXT> joints;
+  xr::HandJointLocationsEXT locations;
+  locations.setJointLocations(joints);
+  EXPECT_EQ(locations.jointCount, static_cast<uint32_t>(XR_HAND_JOINT_COUNT_EXT));
+  locations.getJointLocations()[0].radius = 0.01f;
+  EXPECT_EQ(joints[0].radius, 0.01f);
+}
+
+TEST_F(OpenXrSpanTest, outputBuffersSpanTheWrittenElements) {
+  std::array<xr::Vector2f, 8> vertices;
+  xr::VisibilityMaskKHR mask;
+  mask.setVertices(vertices);
+  EXPECT_EQ(mask.vertexCapacityInput, 8u);
+  EXPECT_EQ(mask.getVertices().size(), 0u);
+
+  mask.vertexCountOutput = 3;
+  EXPECT_EQ(mask.getVertices().data(), vertices.data());
+  EXPECT_EQ(mask.getVertices().size(), 3u);
+
+  // As after a call asking for more than the capacity
+  mask.vertexCountOutput = 20;
+  EXPECT_EQ(mask.getVertices().size(), 8u);
+}
+
+static size_t countIdentity(xr::Span<const xr::Quaternionf> rotations) {
+  size_t count = 0;
+  for (const xr::Quaternionf &rotation : rotations) {
+    if (rotation.w == 1.f) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST_F(OpenXrSpanTest, parametersTakeAnyContiguousRange) {
+  xr::Quaternionf identity;
+  xr::Quaternionf flipped{0.f, 1.f, 0.f, 0.f};
+  EXPECT_EQ(countIdentity({identity, flipped, identity}), 2u);
+
+  std::array<xr::Quaternionf, 2> array{{identity, identity}};
+  EXPECT_EQ(countIdentity(array), 2u);
+
+  std::vector<xr::Quaternionf> vector{flipped};
+  EXPECT_EQ(countIdentity(vector), 0u);
+  EXPECT_EQ(countIdentity({}), 0u);
+
+  // Temporaries too, as with std::span<const T>.
+  EXPECT_EQ(countIdentity(std::vector<xr::Quaternionf>{identity, flipped, identity}), 2u);
+  const std::vector<xr::Quaternionf> constVector{identity};
+  EXPECT_EQ(countIdentity(constVector), 1u);
+}
@@ -0,0 +1,94 @@
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_structure_chain.hpp"
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+static_assert(xr::traits::struct_extends<xr::CompositionLayerDepthInfoKHR, xr::CompositionLayerProjectionView>::value,
+              "CompositionLayerDepthInfoKHR extends CompositionLayerProjectionView");
+static_assert(!xr::traits::struct_extends<xr::CompositionLayerDepthInfoKHR, xr::FrameEndInfo>::value,
+              "CompositionLayerDepthInfoKHR does not extend FrameEndInfo");
+
+class OpenXrStructureChainTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(OpenXrStructureChainTest, linksAtConstruction) {
+  xr::StructureChain<xr::SystemProperties, xr::SystemHandTrackingPropertiesEXT, xr::SystemEyeGazeInteractionPropertiesEXT>
+      chain;
+  auto &props = chain.get<xr::SystemProperties>();
+  auto &handTracking = chain.get<xr::SystemHandTrackingPropertiesEXT>();
+  auto &eyeGaze = chain.get<xr::SystemEyeGazeInteractionPropertiesEXT>();
+  EXPECT_EQ(props.type, xr::StructureType::SystemProperties);
+  EXPECT_EQ(props.next, &handTracking);
+  EXPECT_EQ(handTracking.next, &eyeGaze);
+  EXPECT_EQ(eyeGaze.next, nullptr);
+}
+
+TEST_F(OpenXrStructureChainTest, copyRelinks) {
+  xr::CompositionLayerDepthInfoKHR depthInfo;
+  depthInfo.nearZ = 0.1f;
+  const xr::StructureChain<xr::CompositionLayerProjectionView, xr::CompositionLayerDepthInfoKHR> chain{
+      xr::CompositionLayerProjectionView{}, depthInfo};
+  EXPECT_EQ(chain.get<xr::CompositionLayerDepthInfoKHR>().nearZ, 0.1f);
+
+  auto copy = chain;
+  EXPECT_EQ(copy.get<xr::CompositionLayerProjectionView>().next, &copy.get<xr::CompositionLayerDepthInfoKHR>());
+  EXPECT_EQ(copy.get<xr::CompositionLayerDepthInfoKHR>().nearZ, 0.1f);
+
+  decltype(copy) assigned;
+  assigned = chain;
+  EXPECT_EQ(assigned.get<xr::CompositionLayerProjectionView>().next,
+            &assigned.get<xr::CompositionLayerDepthInfoKHR>());
+}
+
+static_assert(std::is_same<xr::traits::cpp_type_from_structure_type<xr::StructureType::SpaceLocation>::type,
+                           xr::SpaceLocation>::value,
+              "cpp_type_from_structure_type maps SpaceLocation");
+static_assert(xr::traits::structure_type_of<xr::SpaceLocation>::value == xr::StructureType::SpaceLocation,
+              "structure_type_of maps SpaceLocation");
+static_assert(xr::traits::structure_type_of<xr::Vector3f>::value == xr::StructureType::Unknown,
+              "structure_type_of is Unknown for untyped structs");
+
+TEST_F(OpenXrStructureChainTest, findInChain) {
+  xr::StructureChain<xr::SystemProperties, xr::SystemHandTrackingPropertiesEXT> chain;
+  void *next = chain.get<xr::SystemProperties>().next;
+  EXPECT_EQ(xr::findInChain<xr::SystemHandTrackingPropertiesEXT>(next),
+            &chain.get<xr::SystemHandTrackingPropertiesEXT>());
+  EXPECT_EQ(xr::findInChain<xr::SystemEyeGazeInteractionPropertiesEXT>(next), nullptr);
+
+  const xr::StructureChain<xr::CompositionLayerProjectionView, xr::CompositionLayerDepthInfoKHR> layerChain;
+  const void *layerNext = layerChain.get<xr::CompositionLayerProjectionView>().next;
+  EXPECT_EQ(xr::findInChain<xr::CompositionLayerDepthInfoKHR>(layerNext),
+            &layerChain.get<xr::CompositionLayerDepthInfoKHR>());
+}
+
+TEST_F(OpenXrStructureChainTest, rangeAndVisit) {
+  xr::StructureChain<xr::SystemProperties, xr::SystemHandTrackingPropertiesEXT, xr::SystemEyeGazeInteractionPropertiesEXT>
+      chain;
+  size_t length = 0;
+  for (XrBaseOutStructure &s : xr::chainRange(&chain.get<xr::SystemProperties>())) {
+    EXPECT_NE(s.type, XR_TYPE_UNKNOWN);
+    ++length;
+  }
+  EXPECT_EQ(length, 3u);
+
+  chain.get<xr::SystemHandTrackingPropertiesEXT>().supportsHandTracking = true;
+  bool sawHandTracking = false;
+  uint32_t eyeGaze = 0;
+  struct Visitor {
+    bool &sawHandTracking;
+    uint32_t &eyeGaze;
+    void operator()(xr::SystemHandTrackingPropertiesEXT const &props) const {
+      sawHandTracking = static_cast<bool>(props.supportsHandTracking);
+    }
+    void operator()(xr::SystemEyeGazeInteractionPropertiesEXT const &) const { ++eyeGaze; }
+  };
+  xr::visitChain(chain.get<xr::SystemProperties>().next, Visitor{sawHandTracking, eyeGaze});
+  EXPECT_TRUE(sawHandTracking);
+  EXPECT_EQ(eyeGaze, 1u);
+}
@@ -0,0 +1,210 @@
+#define XR_USE_GRAPHICS_API_VULKAN
+
+#include "xr_dependencies.h"
+#include "openxr/openxr_platform.h"
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_swapchain_ring.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime, checking the order of calls on a swapchain of three images.
+struct StubSwapchain {
+  std::mutex mutex;
+  std::condition_variable changed;
+  uint32_t imageCount = 3;
+  uint32_t enumerateCount = 0;
+  uint32_t acquireCount = 0;
+  uint32_t waitCount = 0;
+  uint32_t releaseCount = 0;
+  uint32_t timeoutsLeft = 0;
+  XrResult acquireResult = XR_SUCCESS;
+  std::deque<uint32_t> acquired;
+  bool waited = false;
+  bool orderViolated = false;
+  std::thread::id waitThread;
+
+  void waitForAcquireCount(uint32_t count) {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return acquireCount >= count; });
+  }
+};
+
+struct StubSwapchainDispatch {
+  StubSwapchain *stub;
+
+  XrResult xrEnumerateSwapchainImages(XrSwapchain, uint32_t capacity, uint32_t *count,
+                                      XrSwapchainImageBaseHeader *images) const noexcept {
+    std::lock_guard<std::mutex> lock(stub->mutex);
+    ++stub->enumerateCount;
+    *count = stub->imageCount;
+    if (capacity == 0) {
+      return XR_SUCCESS;
+    }
+    auto vulkanImages = reinterpret_cast<XrSwapchainImageVulkanKHR *>(images);
+    for (uint32_t i = 0; i < stub->imageCount; ++i) {
+      vulkanImages[i].image = reinterpret_cast<VkImage>(static_cast<uintptr_t>(0x100 + i));
+    }
+    return XR_SUCCESS;
+  }
+
+  XrResult xrAcquireSwapchainImage(XrSwapchain, const XrSwapchainImageAcquireInfo *, uint32_t *index) const noexcept {
+    {
+      std::lock_guard<std::mutex> lock(stub->mutex);
+      if (stub->acquireResult != XR_SUCCESS) {
+        return stub->acquireResult;
+      }
+      if (stub->acquired.size() == stub->imageCount) {
+        stub->orderViolated = true;
+        return XR_ERROR_CALL_ORDER_INVALID;
+      }
+      *index = stub->acquireCount % stub->imageCount;
+      stub->acquired.push_back(*index);
+      ++stub->acquireCount;
+    }
+    stub->changed.notify_all();
+    return XR_SUCCESS;
+  }
+
+  XrResult xrWaitSwapchainImage(XrSwapchain, const XrSwapchainImageWaitInfo *) const noexcept {
+    std::lock_guard<std::mutex> lock(stub->mutex);
+    stub->waitThread = std::this_thread::get_id();
+    if (stub->acquired.empty() || stub->waited) {
+      stub->orderViolated = true;
+      return XR_ERROR_CALL_ORDER_INVALID;
+    }
+    if (stub->timeoutsLeft > 0) {
+      --stub->timeoutsLeft;
+      return XR_TIMEOUT_EXPIRED;
+    }
+    ++stub->waitCount;
+    stub->waited = true;
+    return XR_SUCCESS;
+  }
+
+  XrResult xrReleaseSwapchainImage(XrSwapchain, const XrSwapchainImageReleaseInfo *) const noexcept {
+    std::lock_guard<std::mutex> lock(stub->mutex);
+    if (!stub->waited) {
+      stub->orderViolated = true;
+      return XR_ERROR_CALL_ORDER_INVALID;
+    }
+    stub->acquired.pop_front();
+    stub->waited = false;
+    ++stub->releaseCount;
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(StubSwapchainDispatch)
+
+using Ring = xr::SwapchainRing<xr::SwapchainImageVulkanKHR, StubSwapchainDispatch>;
+
+class OpenXrSwapchainRingTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  StubSwapchain stub;
+  StubSwapchainDispatch dispatch{&stub};
+};
+
+TEST_F(OpenXrSwapchainRingTest, imagesAreEnumeratedOnce) {
+  Ring ring{xr::Swapchain{}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  ring.stop();
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  ring.stop();
+
+  EXPECT_EQ(stub.enumerateCount, 2u);
+  ASSERT_EQ(ring.size(), 3u);
+  ASSERT_EQ(ring.images().size(), 3u);
+  EXPECT_EQ(ring.image(2).image, reinterpret_cast<VkImage>(static_cast<uintptr_t>(0x102)));
+  EXPECT_EQ(ring.image(2).type, xr::StructureType::SwapchainImageVulkanKHR);
+}
+
+TEST_F(OpenXrSwapchainRingTest, imagesCycleInOrder) {
+  Ring ring{xr::Swapchain{}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  std::vector<uint32_t> indices;
+  uint32_t index;
+  while (indices.size() < 10 && ring.acquire(index)) {
+    indices.push_back(index);
+    ASSERT_EQ(ring.release(), xr::Result::Success);
+  }
+  ring.stop();
+
+  EXPECT_EQ(indices, (std::vector<uint32_t>{0, 1, 2, 0, 1, 2, 0, 1, 2, 0}));
+  EXPECT_EQ(ring.lastResult(), xr::Result::Success);
+  EXPECT_FALSE(stub.orderViolated);
+  EXPECT_NE(stub.waitThread, std::this_thread::get_id());
+}
+
+TEST_F(OpenXrSwapchainRingTest, nextImageIsAcquiredAhead) {
+  Ring ring{xr::Swapchain{}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  uint32_t index;
+  ASSERT_TRUE(ring.acquire(index));
+  EXPECT_EQ(index, 0u);
+
+  // Image 1 is acquired while image 0 is held, but only waited for once image 0 is released.
+  stub.waitForAcquireCount(2);
+  {
+    std::lock_guard<std::mutex> lock(stub.mutex);
+    EXPECT_EQ(stub.acquired.size(), 2u);
+    EXPECT_EQ(stub.waitCount, 1u);
+  }
+  ASSERT_EQ(ring.release(), xr::Result::Success);
+  uint32_t next;
+  ASSERT_TRUE(ring.acquire(next));
+  EXPECT_EQ(next, 1u);
+  ASSERT_EQ(ring.release(), xr::Result::Success);
+  ring.stop();
+  EXPECT_FALSE(stub.orderViolated);
+}
+
+TEST_F(OpenXrSwapchainRingTest, timeoutsAreRetried) {
+  stub.timeoutsLeft = 5;
+  Ring ring{xr::Swapchain{}, xr::Duration{1000}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  uint32_t index;
+  ASSERT_TRUE(ring.acquire(index));
+  EXPECT_EQ(index, 0u);
+  ASSERT_EQ(ring.release(), xr::Result::Success);
+  ring.stop();
+  EXPECT_EQ(stub.timeoutsLeft, 0u);
+  EXPECT_FALSE(stub.orderViolated);
+}
+
+TEST_F(OpenXrSwapchainRingTest, failuresStopTheHelperThread) {
+  stub.acquireResult = XR_ERROR_RUNTIME_FAILURE;
+  Ring ring{xr::Swapchain{}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  uint32_t index;
+  EXPECT_FALSE(ring.acquire(index));
+  EXPECT_EQ(ring.lastResult(), xr::Result::ErrorRuntimeFailure);
+  ring.stop();
+}
+
+TEST_F(OpenXrSwapchainRingTest, stopKeepsTheNextImage) {
+  Ring ring{xr::Swapchain{}, dispatch};
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  uint32_t index;
+  ASSERT_TRUE(ring.acquire(index));
+  stub.waitForAcquireCount(2);
+  ring.stop();
+  ASSERT_EQ(ring.release(), xr::Result::Success);
+
+  // The image acquired ahead is waited for and returned after restarting.
+  ASSERT_EQ(ring.start(), xr::Result::Success);
+  ASSERT_TRUE(ring.acquire(index));
+  EXPECT_EQ(index, 1u);
+  ASSERT_EQ(ring.release(), xr::Result::Success);
+  ring.stop();
+  EXPECT_FALSE(stub.orderViolated);
+}
@@ -0,0 +1,155 @@
+#define XR_USE_TIMESPEC
+
+#include <time.h>
+
+#include "xr_dependencies.h"
+#include "openxr/openxr_platform.h"
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_time_converter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+// Stands in for a runtime whose clock is ahead of CLOCK_MONOTONIC by an offset, and runs fast by some parts per
+// million.
+struct FakeTimespecDispatch {
+  int64_t offset;
+  double drift;
+  int *calls;
+  bool fail;
+
+  XrTime runtimeTime(int64_t monotonic) const noexcept {
+    return monotonic + offset + static_cast<int64_t>(static_cast<double>(monotonic) * drift);
+  }
+
+  XrResult xrConvertTimespecTimeToTimeKHR(XrInstance, const struct timespec *timespecTime,
+                                          XrTime *time) const noexcept {
+    ++*calls;
+    if (fail) {
+      return XR_ERROR_HANDLE_INVALID;
+    }
+    *time = runtimeTime(static_cast<int64_t>(timespecTime->tv_sec) * 1000000000 + timespecTime->tv_nsec);
+    return XR_SUCCESS;
+  }
+};
+OPENXR_HPP_CLASS_IS_DISPATCH(FakeTimespecDispatch)
+
+namespace {
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+
+std::chrono::steady_clock::time_point steady(nanoseconds t) { return std::chrono::steady_clock::time_point{t}; }
+}  // namespace
+
+class OpenXrTimeTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  int calls = 0;
+  FakeTimespecDispatch dispatch{5000000000, 50e-6, &calls, false};
+};
+
+TEST_F(OpenXrTimeTest, durationsConvertToChrono) {
+  EXPECT_EQ(xr::Duration{milliseconds(5)}.get(), 5000000);
+  EXPECT_EQ(xr::Duration{std::chrono::duration<double>(0.25)}.get(), 250000000);
+  EXPECT_EQ(xr::Duration{1500}.toChrono(), nanoseconds(1500));
+  EXPECT_EQ(std::chrono::duration_cast<milliseconds>(xr::Duration{7000000}.toChrono()), milliseconds(7));
+}
+
+TEST_F(OpenXrTimeTest, timesConvertToChrono) {
+  const xr::Time time{123456789};
+  xr::Time::Clock::time_point point = time.toChrono();
+  EXPECT_EQ(point.time_since_epoch(), nanoseconds(123456789));
+  EXPECT_EQ(xr::Time{point + milliseconds(1)}, time + xr::Duration{milliseconds(1)});
+  EXPECT_EQ(xr::Time{std::chrono::time_point_cast<milliseconds>(point)}.get(), 123000000);
+}
+
+TEST_F(OpenXrTimeTest, converterMatchesRuntimeBetweenSamples) {
+  xr::TimeConverter converter{xr::Instance{}, seconds(1)};
+  EXPECT_FALSE(converter.sampled());
+  const nanoseconds start = seconds(1000);
+  ASSERT_EQ(converter.sample(steady(start), dispatch), xr::Result::Success);
+  ASSERT_EQ(converter.sample(steady(start + seconds(1)), dispatch), xr::Result::Success);
+  EXPECT_TRUE(converter.sampled());
+  EXPECT_NEAR(converter.drift(), 50e-6, 1e-9);
+
+  // Convert a few thousand timestamps over the next second, against the runtime's own conversion.
+  int64_t maxError = 0;
+  for (int64_t t = 0; t < 1000000000; t += 333333) {
+    const nanoseconds now = start + seconds(1) + nanoseconds(t);
+    const int64_t error = converter.toTime(steady(now)).get() - dispatch.runtimeTime(now.count());
+    maxError = std::max(maxError, std::abs(error));
+    const nanoseconds roundTrip = converter.toSteadyClock(xr::Time{dispatch.runtimeTime(now.count())}) - steady(now);
+    EXPECT_LE(std::abs(roundTrip.count()), 1);
+  }
+  RecordProperty("maxErrorNanoseconds", static_cast<int>(maxError));
+  EXPECT_LE(maxError, 2);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST_F(OpenXrTimeTest, converterFollowsDriftChanges) {
+  xr::TimeConverter converter{xr::Instance{}, seconds(1)};
+  const nanoseconds start = seconds(1000);
+  converter.sample(steady(start), dispatch);
+  converter.sample(steady(start + seconds(1)), dispatch);
+
+  // The runtime slews its clock: the error at the next sample is what the converter was off by.
+  dispatch.drift = 80e-6;
+  dispatch.offset -= static_cast<int64_t>(30e-6 * static_cast<double>((start + seconds(1)).count()));
+  converter.sample(steady(start + seconds(2)), dispatch);
+  EXPECT_NEAR(static_cast<double>(converter.lastError().get()), 30000., 2.);
+  converter.sample(steady(start + seconds(3)), dispatch);
+  EXPECT_LE(std::abs(converter.lastError().get()), 2);
+  EXPECT_NEAR(converter.drift(), 80e-6, 1e-9);
+}
+
+TEST_F(OpenXrTimeTest, converterResamplesWhenDue) {
+  xr::TimeConverter converter{xr::Instance{}, milliseconds(500)};
+  const nanoseconds start = seconds(1000);
+  EXPECT_EQ(converter.update(steady(start), dispatch), xr::Result::Success);
+  EXPECT_EQ(calls, 1);
+  converter.update(steady(start + milliseconds(499)), dispatch);
+  EXPECT_EQ(calls, 1);
+  converter.update(steady(start + milliseconds(500)), dispatch);
+  EXPECT_EQ(calls, 2);
+
+  dispatch.fail = true;
+  EXPECT_EQ(converter.update(steady(start + seconds(1)), dispatch), xr::Result::ErrorHandleInvalid);
+  EXPECT_EQ(converter.toTime(steady(start)).get(), dispatch.runtimeTime(start.count()));
+}
+
+TEST_F(OpenXrTimeTest, conversionsSeeWholeSamples) {
+  xr::TimeConverter converter{xr::Instance{}, seconds(1)};
+  const nanoseconds start = seconds(1000);
+  converter.sample(steady(start), dispatch);
+  converter.sample(steady(start + seconds(1)), dispatch);
+
+  // Samples alternate between times 1000 s apart: mixing the fields of two would be off by about that much.
+  std::atomic<bool> converting{false};
+  std::atomic<bool> done{false};
+  std::thread sampler([&] {
+    while (!converting) {
+      std::this_thread::yield();
+    }
+    for (int i = 0; i < 20000; ++i) {
+      converter.sample(steady(start + seconds(i % 2 ? 1000 : 1)), dispatch);
+    }
+    done = true;
+  });
+  const nanoseconds t = start + seconds(500);
+  int64_t maxError = 0;
+  while (!done) {
+    maxError = std::max(maxError, std::abs(converter.toTime(steady(t)).get() - dispatch.runtimeTime(t.count())));
+    converting = true;
+  }
+  sampler.join();
+  EXPECT_LE(maxError, 10);
+}
@@ -0,0 +1,31 @@
+#define XR_USE_TIMESPEC
+
+#include <time.h>
+
+#include "xr_dependencies.h"
+#include "openxr/openxr_platform.h"
+
+// An application-wide extension dispatcher, as OPENXR_HPP_DEFAULT_EXTENSION_DISPATCHER suggests.
+struct ExtensionDispatch {
+  XrResult xrConvertTimespecTimeToTimeKHR(XrInstance, const struct timespec *, XrTime *) const noexcept {
+    return XR_SUCCESS;
+  }
+};
+static ExtensionDispatch extensionDispatch;
+
+#define OPENXR_HPP_DEFAULT_EXTENSION_DISPATCHER extensionDispatch
+#define OPENXR_HPP_DEFAULT_EXTENSION_DISPATCHER_TYPE ExtensionDispatch &
+
+#include "openxr/openxr.hpp"
+#include "openxr/openxr_time_converter.hpp"
+
+OPENXR_HPP_CLASS_IS_DISPATCH(ExtensionDispatch)
+
+// TimeConverter calls an extension function, so it must default to the extension dispatcher, not the core one.
+static void sampleWithTheDefaultDispatch() {
+  xr::TimeConverter converter{xr::Instance{}};
+  static_cast<void>(converter.sample());
+  static_cast<void>(converter.sample(std::chrono::steady_clock::now()));
+  static_cast<void>(converter.update());
+  static_cast<void>(converter.update(std::chrono::steady_clock::now()));
+}
@@ -0,0 +1,67 @@
+#include "openxr/openxr_triple_buffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+class OpenXrTripleBufferTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+namespace {
+struct Sample {
+  uint64_t a = 0;
+  uint64_t b = 0;
+};
+}  // namespace
+
+TEST_F(OpenXrTripleBufferTest, readerGetsTheLatestValue) {
+  xr::TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.front(), 0);
+
+  buffer.back() = 1;
+  buffer.publish();
+  buffer.back() = 2;
+  buffer.publish();
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.front(), 2);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.front(), 2);
+
+  buffer.back() = 3;
+  buffer.publish();
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.front(), 3);
+}
+
+TEST_F(OpenXrTripleBufferTest, valuesAreNeverTorn) {
+  xr::TripleBuffer<Sample> buffer;
+  constexpr uint64_t kValues = 100000;
+  std::thread writer([&] {
+    for (uint64_t i = 1; i <= kValues; ++i) {
+      buffer.back().a = i;
+      buffer.back().b = i * 3;
+      buffer.publish();
+    }
+  });
+  uint64_t last = 0;
+  bool torn = false;
+  bool backwards = false;
+  while (last < kValues) {
+    if (buffer.update()) {
+      Sample const &sample = buffer.front();
+      torn = torn || sample.b != sample.a * 3;
+      backwards = backwards || sample.a <= last;
+      last = sample.a;
+    }
+  }
+  writer.join();
+  EXPECT_FALSE(torn);
+  EXPECT_FALSE(backwards);
+}
@@ -0,0 +1,54 @@
+#include "openxr/openxr.hpp"
+
+#include <cstring>
+#include <new>
+
+#include <gtest/gtest.h>
+
+class OpenXrUninitializedTest : public ::testing::Test {
+protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+static const unsigned char POISON = 0xA5;
+
+// Count the bytes of a poisoned buffer that differ from the poison after running f on it.
+template <typename T, typename F>
+static size_t bytesWritten(F &&f) {
+  alignas(T) unsigned char storage[sizeof(T)];
+  memset(storage, POISON, sizeof(storage));
+  f(storage);
+  size_t written = 0;
+  for (unsigned char c : storage) {
+    if (c != POISON) {
+      ++written;
+    }
+  }
+  return written;
+}
+
+TEST_F(OpenXrUninitializedTest, systemPropertiesBytesWritten) {
+  // What the enhanced wrappers used to do for a single output.
+  size_t before = bytesWritten<xr::SystemProperties>([](unsigned char *storage) {
+    auto *props = new (storage) xr::SystemProperties;
+    xr::put(*props);
+  });
+  // What they do now.
+  size_t after = bytesWritten<xr::SystemProperties>([](unsigned char *storage) {
+    auto *props = new (storage) xr::SystemProperties{xr::Uninitialized{}};
+    xr::put(*props, false);
+  });
+  EXPECT_LT(after, before);
+}
+
+TEST_F(OpenXrUninitializedTest, typeAndNextAreSet) {
+  xr::SystemProperties props{xr::Uninitialized{}};
+  EXPECT_EQ(props.type, xr::StructureType::SystemProperties);
+  EXPECT_EQ(props.next, nullptr);
+
+  xr::SpaceLocation location{xr::Uninitialized{}};
+  EXPECT_EQ(location.type, xr::StructureType::SpaceLocation);
+  EXPECT_EQ(location.next, nullptr);
+}
@@ -0,0 +1,73 @@
+#include "openxr/openxr.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+struct LayerCounter {
+  int projections = 0;
+  int quads = 0;
+  int unknown = 0;
+
+  void operator()(xr::CompositionLayerProjection const &) { ++projections; }
+  void operator()(xr::CompositionLayerQuad const &) { ++quads; }
+  void operator()(xr::CompositionLayerBaseHeader const &) { ++unknown; }
+};
+
+struct QuadWidth {
+  float width = 0.f;
+
+  void operator()(xr::CompositionLayerQuad const &quad) { width += quad.size.width; }
+};
+}  // namespace
+
+class OpenXrVisitTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    quad.size = xr::Extent2Df{2.f, 1.f};
+    layers[0] = &projection;
+    layers[1] = &quad;
+  }
+
+  void TearDown() override {}
+
+  xr::CompositionLayerProjection projection;
+  xr::CompositionLayerQuad quad;
+  const xr::CompositionLayerBaseHeader *layers[2];
+};
+
+TEST_F(OpenXrVisitTest, layersAreDispatchedByType) {
+  LayerCounter counter;
+  for (const xr::CompositionLayerBaseHeader *layer : layers) {
+    EXPECT_TRUE(xr::visit(*layer, counter));
+  }
+  EXPECT_EQ(counter.projections, 1);
+  EXPECT_EQ(counter.quads, 1);
+  EXPECT_EQ(counter.unknown, 0);
+}
+
+TEST_F(OpenXrVisitTest, unhandledTypesAreIgnored) {
+  QuadWidth quadWidth;
+  for (const xr::CompositionLayerBaseHeader *layer : layers) {
+    xr::visit(*layer, quadWidth);
+  }
+  EXPECT_EQ(quadWidth.width, 2.f);
+}
+
+TEST_F(OpenXrVisitTest, unknownTypesGoToTheBase) {
+  xr::CompositionLayerQuad unknown = quad;
+  unknown.type = xr::StructureType::Unknown;
+  LayerCounter counter;
+  EXPECT_FALSE(xr::visit(unknown, counter));
+  EXPECT_EQ(counter.unknown, 1);
+}
+
+TEST_F(OpenXrVisitTest, hapticsAreDispatchedByType) {
+  xr::HapticVibration vibration{xr::Duration{1000}, XR_FREQUENCY_UNSPECIFIED, 0.5f};
+  float amplitude = 0.f;
+  struct {
+    float &amplitude;
+    void operator()(xr::HapticVibration const &v) { amplitude = v.amplitude; }
+  } visitor{amplitude};
+  EXPECT_TRUE(xr::visit(static_cast<xr::HapticBaseHeader const &>(vibration), visitor));
+  EXPECT_EQ(amplitude, 0.5f);
+}